@@ -2,10 +2,15 @@
 #define DUNE_SPGRID_HH
 
 #include <dune/grid/spgrid/backuprestore.hh>
+#include <dune/grid/spgrid/decompositionreport.hh>
+#include <dune/grid/spgrid/entityrange.hh>
+#include <dune/grid/spgrid/foreachindex.hh>
 #include <dune/grid/spgrid/grid.hh>
 #include <dune/grid/spgrid/hierarchicsearch.hh>
 #include <dune/grid/spgrid/persistentcontainer.hh>
+#include <dune/grid/spgrid/rowgeometry.hh>
 #include <dune/grid/spgrid/tree.hh>
+#include <dune/grid/spgrid/wavefront.hh>
 
 namespace Dune
 {
@@ -27,9 +32,9 @@ namespace Dune
     // TwistUtility for SPGrid
     // -----------------------
 
-    template< class ct, int dim, template< int > class Ref, class Comm >
-    struct TwistUtility< SPGrid< ct, dim, Ref, Comm > >
-      : public TwistFreeTwistUtility< SPGrid< ct, dim, Ref, Comm > >
+    template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+    struct TwistUtility< SPGrid< ct, dim, Ref, Comm, Index > >
+      : public TwistFreeTwistUtility< SPGrid< ct, dim, Ref, Comm, Index > >
     {};
 
   } // end namespace Fem
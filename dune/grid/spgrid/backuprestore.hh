@@ -33,10 +33,10 @@ namespace Dune
    *
    *  \tparam  Grid  type of grid
    */
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  struct BackupRestoreFacility< SPGrid< ct, dim, Ref, Comm > >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  struct BackupRestoreFacility< SPGrid< ct, dim, Ref, Comm, Index > >
   {
-    typedef SPGrid< ct, dim, Ref, Comm > Grid;
+    typedef SPGrid< ct, dim, Ref, Comm, Index > Grid;
 
     typedef typename Grid::Communication Communication;
 
@@ -165,7 +165,7 @@ namespace Dune
       ioData.maxLevel = grid.maxLevel();
       ioData.refinements.resize( ioData.maxLevel );
       for( int level = 0; level < ioData.maxLevel; ++level )
-        ioData.refinements[ level ] = grid.gridLevel( level+1 ).refinement().policy();
+        ioData.refinements[ level ] = grid.refinement( level+1 ).policy();
     }
 
     static Grid *restore ( const SPGridIOData< ct, dim, Ref > &ioData,
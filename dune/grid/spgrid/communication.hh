@@ -1,6 +1,9 @@
 #ifndef DUNE_SPGRID_COMMUNICATION_HH
 #define DUNE_SPGRID_COMMUNICATION_HH
 
+#include <algorithm>
+#include <vector>
+
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/parallel/communication.hh>
 #include <dune/common/parallel/mpicommunication.hh>
@@ -34,6 +37,11 @@ namespace Dune
     {
       return Communication();
     }
+
+    static std::vector< int > sharedMemoryNodes ( const Communication &comm )
+    {
+      return std::vector< int >( comm.size(), 0 );
+    }
   };
 
 #if HAVE_MPI
@@ -51,6 +59,30 @@ namespace Dune
     {
       return comm( MPI_COMM_WORLD );
     }
+
+    /**
+     * \brief index of the shared memory node of each rank
+     *
+     * Nodes are numbered in the order of their lowest rank.
+     */
+    static std::vector< int > sharedMemoryNodes ( const Communication &comm )
+    {
+      MPI_Comm nodeComm;
+      MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, comm.rank(), MPI_INFO_NULL, &nodeComm );
+      int leader = comm.rank();
+      MPI_Allreduce( MPI_IN_PLACE, &leader, 1, MPI_INT, MPI_MIN, nodeComm );
+      MPI_Comm_free( &nodeComm );
+
+      std::vector< int > node( comm.size() );
+      comm.allgather( &leader, 1, node.data() );
+
+      std::vector< int > leaders( node );
+      std::sort( leaders.begin(), leaders.end() );
+      leaders.erase( std::unique( leaders.begin(), leaders.end() ), leaders.end() );
+      for( int &k : node )
+        k = std::lower_bound( leaders.begin(), leaders.end(), k ) - leaders.begin();
+      return node;
+    }
   };
 #endif // #if HAVE_MPI
 
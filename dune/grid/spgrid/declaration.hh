@@ -1,6 +1,8 @@
 #ifndef DUNE_SPGRID_DECLARATION_HH
 #define DUNE_SPGRID_DECLARATION_HH
 
+#include <dune/grid/common/gridenums.hh>
+
 namespace Dune
 {
 
@@ -16,9 +18,14 @@ namespace Dune
   template< int >
   class SPBisectionRefinement;
 
-  template< class, int, template< int > class, class >
+  template< class, int, template< int > class, class, class >
   class SPGrid;
 
+  struct SPLexicographicOrdering;
+
+  template< class Grid, class Ordering = SPLexicographicOrdering, PartitionIteratorType pitype = All_Partition >
+  class SPIndexSet;
+
 } // namespace Dune
 
 #endif // #ifndef DUNE_SPGRID_DECLARATION_HH
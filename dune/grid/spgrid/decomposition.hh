@@ -2,6 +2,14 @@
 #define DUNE_SPGRID_DECOMPOSITION_HH
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <dune/grid/common/exceptions.hh>
 
 #include <dune/grid/spgrid/mesh.hh>
 #include <dune/grid/spgrid/multiindex.hh>
@@ -23,21 +31,36 @@ namespace Dune
     typedef SPMultiIndex< dimension > MultiIndex;
     typedef SPMesh< dimension > Mesh;
 
+    /** \brief cost of a macro cell, given by its (cell) multi-index */
+    typedef std::function< double( const MultiIndex & ) > Weight;
+
   private:
     struct Node
     {
       Node ( const Mesh &mesh, const unsigned int size );
+      Node ( const Mesh &mesh, const unsigned int size, const Mesh &root, const std::vector< double > &weights );
+      Node ( const Mesh &root, const MultiIndex &layout, const MultiIndex &first, const MultiIndex &last );
+      Node ( const Mesh &mesh, const unsigned int *count, const unsigned int n );
       ~Node ();
 
+      Node ( const Node & ) = delete;
+      Node &operator= ( const Node & ) = delete;
+
       const Mesh &mesh () const;
       const Mesh &subMesh ( const unsigned int rank ) const;
       void subMeshes ( std::vector< Mesh > &meshes ) const;
+      void intersect ( const Mesh &mesh, const unsigned int offset, std::vector< unsigned int > &blocks ) const;
 
       unsigned int size () const;
 
     private:
+      void bisect ();
+
+      static int splitWeighted ( const Mesh &mesh, const int dir, const int leftWeight, const int rightWeight,
+                                 const Mesh &root, const std::vector< double > &weights );
+
       Mesh mesh_;
-      unsigned int size_;
+      unsigned int size_, leftSize_;
       Node *left_, *right_;
     };
 
@@ -45,14 +68,121 @@ namespace Dune
     SPDecomposition ( const Mesh &mesh, const unsigned int size );
     SPDecomposition ( const MultiIndex &width, const unsigned int size );
 
+    /**
+     * \brief construct a weighted decomposition
+     *
+     * The split points of the recursive bisection are chosen such that the
+     * summed weight (instead of the number of cells) of each sub-mesh is
+     * proportional to the number of ranks assigned to it.
+     *
+     * \param[in]  mesh     mesh to decompose
+     * \param[in]  size     number of sub-meshes
+     * \param[in]  weights  nonnegative weight of each cell (lexicographically
+     *                      ordered within the mesh, first index running fastest)
+     */
+    SPDecomposition ( const Mesh &mesh, const unsigned int size, const std::vector< double > &weights );
+    SPDecomposition ( const MultiIndex &width, const unsigned int size, const std::vector< double > &weights );
+
+    /**
+     * \brief construct a weighted decomposition
+     *
+     * \param[in]  mesh    mesh to decompose
+     * \param[in]  size    number of sub-meshes
+     * \param[in]  weight  callback returning the nonnegative cost of a cell
+     */
+    SPDecomposition ( const Mesh &mesh, const unsigned int size, const Weight &weight );
+    SPDecomposition ( const MultiIndex &width, const unsigned int size, const Weight &weight );
+
+    /**
+     * \brief construct a processor grid decomposition
+     *
+     * The mesh is cut into a tensor product grid of layout[ 0 ] x ... x
+     * layout[ dim-1 ] blocks, where the free entries (layout[ i ] = 0) are
+     * chosen to minimize the total interface area (see processorGrid).
+     * Pin an axis by prescribing its number of blocks; in particular,
+     * layout[ i ] = 1 keeps axis i undecomposed.
+     *
+     * Ranks are numbered lexicographically within the processor grid, the
+     * first axis running fastest.
+     *
+     * \param[in]  mesh    mesh to decompose
+     * \param[in]  size    number of sub-meshes
+     * \param[in]  layout  number of blocks per axis (0 = free)
+     */
+    SPDecomposition ( const Mesh &mesh, const unsigned int size, const MultiIndex &layout );
+    SPDecomposition ( const MultiIndex &width, const unsigned int size, const MultiIndex &layout );
+
+    /**
+     * \brief construct a hierarchical decomposition
+     *
+     * The mesh is first bisected among the shared memory nodes (each node
+     * receiving a share proportional to its number of ranks). Each node's
+     * block is then bisected among its ranks, keeping most of the interface
+     * between sub-meshes within a node.
+     *
+     * \param[in]  mesh     mesh to decompose
+     * \param[in]  node     index of the shared memory node of each rank
+     *                      (see SPCommunicationTraits::sharedMemoryNodes)
+     * \param[in]  reorder  assign the blocks of a node to the ranks actually
+     *                      residing on that node; otherwise, blocks are
+     *                      assigned in order, which only keeps node locality
+     *                      if the ranks of each node are numbered contiguously
+     */
+    SPDecomposition ( const Mesh &mesh, const std::vector< int > &node, const bool reorder = true );
+    SPDecomposition ( const MultiIndex &width, const std::vector< int > &node, const bool reorder = true );
+
     const Mesh &mesh () const;
     const Mesh &subMesh ( const unsigned int rank ) const;
     std::vector< Mesh > subMeshes () const;
 
     unsigned int size () const;
 
+    bool operator== ( const This &other ) const;
+    bool operator!= ( const This &other ) const { return !(*this == other); }
+
+    /**
+     * \brief find all ranks whose sub-mesh intersects a given mesh
+     *
+     * The decomposition tree is searched geometrically, so the cost depends
+     * on the number of ranks found rather than on the total number of ranks.
+     *
+     * \note Sub-meshes touching the given mesh are also reported.
+     *
+     * \param[in]   mesh   mesh to intersect with
+     * \param[out]  ranks  ranks are appended to this vector
+     */
+    void intersect ( const Mesh &mesh, std::vector< unsigned int > &ranks ) const;
+
+    /** \brief index of the block (in depth-first order) assigned to a rank */
+    unsigned int block ( const unsigned int rank ) const;
+
+    /** \brief rank a block (in depth-first order) is assigned to */
+    unsigned int rank ( const unsigned int block ) const;
+
+    /**
+     * \brief find a processor grid minimizing the total interface area
+     *
+     * Similar to MPI_Dims_create, this method distributes size ranks onto a
+     * tensor product grid. Among all factorizations respecting the given
+     * layout, the one with the smallest number of interior faces is chosen.
+     * Ties are broken by the size of the largest block.
+     *
+     * \param[in]  width   number of cells in each direction
+     * \param[in]  size    number of ranks
+     * \param[in]  layout  number of blocks per axis (0 = free)
+     *
+     * \returns number of blocks in each direction
+     */
+    static MultiIndex processorGrid ( const MultiIndex &width, const unsigned int size, const MultiIndex &layout );
+
   private:
-    Node root_;
+    static void processorGrid ( const MultiIndex &width, const int i, unsigned int size, MultiIndex &layout,
+                                MultiIndex &best, double &bestArea, double &bestVolume );
+
+    static std::vector< double > tabulate ( const Mesh &mesh, const Weight &weight );
+
+    std::shared_ptr< const Node > root_;
+    std::shared_ptr< const std::vector< unsigned int > > block_, rank_;
   };
 
 
@@ -64,6 +194,20 @@ namespace Dune
   inline SPDecomposition< dim >::Node::Node ( const Mesh &mesh, const unsigned int size )
   : mesh_( mesh ),
     size_( size ),
+    leftSize_( size/2 ),
+    left_( 0 ),
+    right_( 0 )
+  {
+    bisect();
+  }
+
+
+  template< int dim >
+  inline SPDecomposition< dim >::Node
+    ::Node ( const Mesh &mesh, const unsigned int size, const Mesh &root, const std::vector< double > &weights )
+  : mesh_( mesh ),
+    size_( size ),
+    leftSize_( size/2 ),
     left_( 0 ),
     right_( 0 )
   {
@@ -72,11 +216,82 @@ namespace Dune
       const int leftWeight = size_/2;
       const int rightWeight = size_ - leftWeight;
 
+      const MultiIndex &width = mesh.width();
+      const int dir = std::max_element( width.begin(), width.end() ) - width.begin();
+      const int leftWidth = splitWeighted( mesh_, dir, leftWeight, rightWeight, root, weights );
+
+      MultiIndex lend = mesh_.end();
+      MultiIndex rbegin = mesh_.begin();
+      rbegin[ dir ] = lend[ dir ] = mesh_.begin()[ dir ] + leftWidth;
+      left_ = new Node( Mesh( mesh_.begin(), lend ), leftWeight, root, weights );
+      right_ = new Node( Mesh( rbegin, mesh_.end() ), rightWeight, root, weights );
+    }
+  }
+
+
+  template< int dim >
+  inline SPDecomposition< dim >::Node
+    ::Node ( const Mesh &root, const MultiIndex &layout, const MultiIndex &first, const MultiIndex &last )
+  : mesh_( root ),
+    size_( 1 ),
+    leftSize_( 0 ),
+    left_( 0 ),
+    right_( 0 )
+  {
+    // block k in direction i covers the cells [ k*w/p, (k+1)*w/p [
+    MultiIndex begin, end;
+    for( int i = 0; i < dimension; ++i )
+    {
+      const long w = root.width( i );
+      begin[ i ] = root.begin()[ i ] + int( (first[ i ] * w) / layout[ i ] );
+      end[ i ] = root.begin()[ i ] + int( (last[ i ] * w) / layout[ i ] );
+      size_ *= (last[ i ] - first[ i ]);
+    }
+    mesh_ = Mesh( begin, end );
+
+    // split the slowest direction first to obtain a lexicographic numbering
+    for( int i = dimension-1; i >= 0; --i )
+    {
+      if( last[ i ] - first[ i ] < 2 )
+        continue;
+
+      MultiIndex middle = last;
+      middle[ i ] = (first[ i ] + last[ i ]) / 2;
+      left_ = new Node( root, layout, first, middle );
+      middle = first;
+      middle[ i ] = (first[ i ] + last[ i ]) / 2;
+      right_ = new Node( root, layout, middle, last );
+      leftSize_ = left_->size();
+      break;
+    }
+  }
+
+
+  template< int dim >
+  inline SPDecomposition< dim >::Node
+    ::Node ( const Mesh &mesh, const unsigned int *count, const unsigned int n )
+  : mesh_( mesh ),
+    size_( std::accumulate( count, count+n, 0u ) ),
+    leftSize_( 0 ),
+    left_( 0 ),
+    right_( 0 )
+  {
+    assert( n > 0 );
+    if( n > 1 )
+    {
+      const unsigned int leftSize = std::accumulate( count, count+n/2, 0u );
+
       const MultiIndex &width = mesh.width();
       const std::pair< Mesh, Mesh > split
-        = mesh_.split( std::max_element( width.begin(), width.end() ) - width.begin(), leftWeight, rightWeight );
-      left_ = new Node( split.first, leftWeight );
-      right_ = new Node( split.second, rightWeight );
+        = mesh_.split( std::max_element( width.begin(), width.end() ) - width.begin(), leftSize, size_ - leftSize );
+      left_ = new Node( split.first, count, n/2 );
+      right_ = new Node( split.second, count + n/2, n - n/2 );
+      leftSize_ = leftSize;
+    }
+    else
+    {
+      leftSize_ = size_/2;
+      bisect();
     }
   }
 
@@ -89,6 +304,23 @@ namespace Dune
   }
 
 
+  template< int dim >
+  inline void SPDecomposition< dim >::Node::bisect ()
+  {
+    if( size_ > 1 )
+    {
+      const int leftWeight = leftSize_;
+      const int rightWeight = size_ - leftWeight;
+
+      const MultiIndex &width = mesh_.width();
+      const std::pair< Mesh, Mesh > split
+        = mesh_.split( std::max_element( width.begin(), width.end() ) - width.begin(), leftWeight, rightWeight );
+      left_ = new Node( split.first, leftWeight );
+      right_ = new Node( split.second, rightWeight );
+    }
+  }
+
+
   template< int dim >
   inline const typename SPDecomposition< dim >::Mesh &
   SPDecomposition< dim >::Node::mesh () const
@@ -105,10 +337,10 @@ namespace Dune
     if( size_ > 1 )
     {
       assert( (left_ != 0) && (right_ != 0) );
-      if( rank < size_/2 )
+      if( rank < leftSize_ )
         return left_->subMesh( rank );
       else
-        return right_->subMesh( rank - size_/2 );
+        return right_->subMesh( rank - leftSize_ );
     }
     else
       return mesh();
@@ -130,6 +362,24 @@ namespace Dune
   }
 
 
+  template< int dim >
+  inline void
+  SPDecomposition< dim >::Node::intersect ( const Mesh &mesh, const unsigned int offset, std::vector< unsigned int > &blocks ) const
+  {
+    if( mesh_.intersect( mesh ).empty() )
+      return;
+
+    if( size_ > 1 )
+    {
+      assert( (left_ != 0) && (right_ != 0) );
+      left_->intersect( mesh, offset, blocks );
+      right_->intersect( mesh, offset + leftSize_, blocks );
+    }
+    else
+      blocks.push_back( offset );
+  }
+
+
   template< int dim >
   inline unsigned int SPDecomposition< dim >::Node::size () const
   {
@@ -137,6 +387,64 @@ namespace Dune
   }
 
 
+  template< int dim >
+  inline int SPDecomposition< dim >::Node
+    ::splitWeighted ( const Mesh &mesh, const int dir, const int leftWeight, const int rightWeight,
+                      const Mesh &root, const std::vector< double > &weights )
+  {
+    const int width = mesh.width( dir );
+
+    // without a choice, fall back to splitting by cell count
+    if( (width < 2) || mesh.empty() )
+      return (leftWeight * width) / (leftWeight + rightWeight);
+
+    // accumulate the weight of each slice orthogonal to dir
+    std::vector< double > slice( width, 0.0 );
+    const MultiIndex &begin = mesh.begin();
+    const MultiIndex &end = mesh.end();
+    MultiIndex cell = begin;
+    for( bool done = (mesh.volume() <= 0); !done; )
+    {
+      std::size_t index = 0, factor = 1;
+      for( int i = 0; i < dimension; ++i )
+      {
+        index += std::size_t( cell[ i ] - root.begin()[ i ] ) * factor;
+        factor *= std::size_t( root.width( i ) );
+      }
+      slice[ cell[ dir ] - begin[ dir ] ] += weights[ index ];
+
+      done = true;
+      for( int i = 0; (i < dimension) && done; ++i )
+      {
+        done = (++cell[ i ] == end[ i ]);
+        if( done )
+          cell[ i ] = begin[ i ];
+      }
+    }
+
+    // find the split point closest to the target weight; each side keeps at least one slice
+    double total = 0.0;
+    for( const double w : slice )
+      total += w;
+    if( total <= 0.0 )
+      return (leftWeight * width) / (leftWeight + rightWeight);
+    const double target = (total * leftWeight) / (leftWeight + rightWeight);
+
+    int leftWidth = 1;
+    double sum = slice[ 0 ];
+    double deviation = std::abs( sum - target );
+    for( int k = 2; k < width; ++k )
+    {
+      sum += slice[ k-1 ];
+      if( std::abs( sum - target ) >= deviation )
+        break;
+      deviation = std::abs( sum - target );
+      leftWidth = k;
+    }
+    return leftWidth;
+  }
+
+
 
   // Implementation of SPDecomposition
   // ---------------------------------
@@ -144,14 +452,106 @@ namespace Dune
   template< int dim >
   inline SPDecomposition< dim >
     ::SPDecomposition ( const Mesh &mesh, const unsigned int size )
-  : root_( mesh, size )
+  : root_( new Node( mesh, size ) )
   {}
 
 
   template< int dim >
   inline SPDecomposition< dim >
     ::SPDecomposition ( const MultiIndex &width, const unsigned int size )
-  : root_( Mesh( width ), size )
+  : root_( new Node( Mesh( width ), size ) )
+  {}
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const Mesh &mesh, const unsigned int size, const std::vector< double > &weights )
+  {
+    if( std::size_t( std::max( mesh.volume(), 0l ) ) != weights.size() )
+      DUNE_THROW( GridError, "Number of weights (" << weights.size() << ") does not match number of cells in " << mesh << "." );
+    if( std::any_of( weights.begin(), weights.end(), [] ( double w ) { return !(w >= 0.0); } ) )
+      DUNE_THROW( GridError, "Cell weights must be nonnegative." );
+    root_.reset( new Node( mesh, size, mesh, weights ) );
+  }
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const MultiIndex &width, const unsigned int size, const std::vector< double > &weights )
+  : SPDecomposition( Mesh( width ), size, weights )
+  {}
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const Mesh &mesh, const unsigned int size, const Weight &weight )
+  : SPDecomposition( mesh, size, tabulate( mesh, weight ) )
+  {}
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const MultiIndex &width, const unsigned int size, const Weight &weight )
+  : SPDecomposition( Mesh( width ), size, weight )
+  {}
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const Mesh &mesh, const unsigned int size, const MultiIndex &layout )
+  {
+    const MultiIndex grid = processorGrid( mesh.width(), size, layout );
+    root_.reset( new Node( mesh, grid, MultiIndex::zero(), grid ) );
+  }
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const MultiIndex &width, const unsigned int size, const MultiIndex &layout )
+  : SPDecomposition( Mesh( width ), size, layout )
+  {}
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const Mesh &mesh, const std::vector< int > &node, const bool reorder )
+  {
+    const unsigned int size = node.size();
+    if( size == 0 )
+      DUNE_THROW( GridError, "Cannot decompose a mesh onto 0 ranks." );
+    if( std::any_of( node.begin(), node.end(), [ size ] ( int k ) { return (k < 0) || (k >= int( size )); } ) )
+      DUNE_THROW( GridError, "Invalid shared memory node index." );
+
+    // count ranks per node (removing indices without ranks)
+    std::vector< unsigned int > count( size, 0u );
+    for( int k : node )
+      ++count[ k ];
+    std::vector< unsigned int > offset( size+1, 0u );
+    for( unsigned int k = 0; k < size; ++k )
+      offset[ k+1 ] = offset[ k ] + count[ k ];
+    count.erase( std::remove( count.begin(), count.end(), 0u ), count.end() );
+
+    root_.reset( new Node( mesh, count.data(), count.size() ) );
+
+    // the blocks of each node are assigned to its ranks in ascending order
+    if( reorder )
+    {
+      std::vector< unsigned int > block( size ), rank( size );
+      for( unsigned int r = 0; r < size; ++r )
+      {
+        block[ r ] = offset[ node[ r ] ]++;
+        rank[ block[ r ] ] = r;
+      }
+      block_.reset( new std::vector< unsigned int >( std::move( block ) ) );
+      rank_.reset( new std::vector< unsigned int >( std::move( rank ) ) );
+    }
+  }
+
+
+  template< int dim >
+  inline SPDecomposition< dim >
+    ::SPDecomposition ( const MultiIndex &width, const std::vector< int > &node, const bool reorder )
+  : SPDecomposition( Mesh( width ), node, reorder )
   {}
 
 
@@ -159,7 +559,7 @@ namespace Dune
   inline const typename SPDecomposition< dim >::Mesh &
   SPDecomposition< dim >::mesh () const
   {
-    return root_.mesh();
+    return root_->mesh();
   }
 
 
@@ -167,7 +567,7 @@ namespace Dune
   inline const typename SPDecomposition< dim >::Mesh &
   SPDecomposition< dim >::subMesh ( const unsigned int rank ) const
   {
-    return root_.subMesh( rank );
+    return root_->subMesh( block( rank ) );
   }
 
 
@@ -176,8 +576,15 @@ namespace Dune
   SPDecomposition< dim >::subMeshes () const
   {
     std::vector< Mesh > meshes;
-    meshes.reserve( root_.size() );
-    root_.subMeshes( meshes );
+    meshes.reserve( root_->size() );
+    root_->subMeshes( meshes );
+    if( rank_ )
+    {
+      std::vector< Mesh > blocks;
+      blocks.swap( meshes );
+      for( unsigned int r = 0; r < blocks.size(); ++r )
+        meshes.push_back( blocks[ block( r ) ] );
+    }
     return meshes;
   }
 
@@ -185,7 +592,150 @@ namespace Dune
   template< int dim >
   inline unsigned int SPDecomposition< dim >::size () const
   {
-    return root_.size();
+    return root_->size();
+  }
+
+
+  template< int dim >
+  inline bool SPDecomposition< dim >::operator== ( const This &other ) const
+  {
+    if( (mesh().begin() != other.mesh().begin()) || (mesh().end() != other.mesh().end()) || (size() != other.size()) )
+      return false;
+    for( unsigned int rank = 0; rank < size(); ++rank )
+    {
+      const Mesh &subMesh = this->subMesh( rank );
+      const Mesh &otherSubMesh = other.subMesh( rank );
+      if( (subMesh.begin() != otherSubMesh.begin()) || (subMesh.end() != otherSubMesh.end()) )
+        return false;
+    }
+    return true;
+  }
+
+
+  template< int dim >
+  inline void
+  SPDecomposition< dim >::intersect ( const Mesh &mesh, std::vector< unsigned int > &ranks ) const
+  {
+    const std::size_t first = ranks.size();
+    root_->intersect( mesh, 0u, ranks );
+    for( std::size_t i = first; i < ranks.size(); ++i )
+      ranks[ i ] = rank( ranks[ i ] );
+  }
+
+
+  template< int dim >
+  inline unsigned int SPDecomposition< dim >::block ( const unsigned int rank ) const
+  {
+    assert( rank < size() );
+    return (block_ ? (*block_)[ rank ] : rank);
+  }
+
+
+  template< int dim >
+  inline unsigned int SPDecomposition< dim >::rank ( const unsigned int block ) const
+  {
+    assert( block < size() );
+    return (rank_ ? (*rank_)[ block ] : block);
+  }
+
+
+  template< int dim >
+  inline typename SPDecomposition< dim >::MultiIndex
+  SPDecomposition< dim >::processorGrid ( const MultiIndex &width, const unsigned int size, const MultiIndex &layout )
+  {
+    unsigned int pinned = 1;
+    for( int i = 0; i < dimension; ++i )
+    {
+      if( layout[ i ] < 0 )
+        DUNE_THROW( GridError, "Invalid processor grid layout: " << layout << "." );
+      pinned *= std::max( layout[ i ], 1 );
+    }
+    if( (size == 0) || (size % pinned != 0) )
+      DUNE_THROW( GridError, "Processor grid layout " << layout << " does not fit " << size << " ranks." );
+
+    MultiIndex current = layout;
+    MultiIndex best = MultiIndex::zero();
+    double bestArea = std::numeric_limits< double >::infinity();
+    double bestVolume = std::numeric_limits< double >::infinity();
+    processorGrid( width, 0, size / pinned, current, best, bestArea, bestVolume );
+
+    if( bestArea == std::numeric_limits< double >::infinity() )
+      DUNE_THROW( GridError, "Cannot distribute mesh of width " << width << " onto " << size << " ranks using layout " << layout << "." );
+    return best;
+  }
+
+
+  template< int dim >
+  inline void
+  SPDecomposition< dim >::processorGrid ( const MultiIndex &width, const int i, unsigned int size, MultiIndex &layout,
+                                          MultiIndex &best, double &bestArea, double &bestVolume )
+  {
+    if( i == dimension )
+    {
+      if( size != 1 )
+        return;
+
+      // every block must contain at least one cell
+      double area = 0.0, volume = 1.0;
+      for( int j = 0; j < dimension; ++j )
+      {
+        if( layout[ j ] > width[ j ] )
+          return;
+
+        double face = double( layout[ j ] - 1 );
+        for( int k = 0; k < dimension; ++k )
+          face *= (k != j ? double( width[ k ] ) : 1.0);
+        area += face;
+        volume *= double( (width[ j ] + layout[ j ] - 1) / layout[ j ] );
+      }
+
+      if( (area < bestArea) || ((area == bestArea) && (volume < bestVolume)) )
+      {
+        best = layout;
+        bestArea = area;
+        bestVolume = volume;
+      }
+      return;
+    }
+
+    if( layout[ i ] > 0 )
+      return processorGrid( width, i+1, size, layout, best, bestArea, bestVolume );
+
+    // try all divisors of the remaining number of ranks
+    for( unsigned int p = 1; p <= size; ++p )
+    {
+      if( size % p != 0 )
+        continue;
+      layout[ i ] = p;
+      processorGrid( width, i+1, size / p, layout, best, bestArea, bestVolume );
+    }
+    layout[ i ] = 0;
+  }
+
+
+  template< int dim >
+  inline std::vector< double >
+  SPDecomposition< dim >::tabulate ( const Mesh &mesh, const Weight &weight )
+  {
+    std::vector< double > weights;
+    if( mesh.volume() <= 0 )
+      return weights;
+
+    weights.reserve( mesh.volume() );
+    MultiIndex cell = mesh.begin();
+    for( bool done = false; !done; )
+    {
+      weights.push_back( weight( cell ) );
+
+      done = true;
+      for( int i = 0; (i < dimension) && done; ++i )
+      {
+        done = (++cell[ i ] == mesh.end()[ i ]);
+        if( done )
+          cell[ i ] = mesh.begin()[ i ];
+      }
+    }
+    return weights;
   }
 
 } // namespace Dune
@@ -0,0 +1,231 @@
+#ifndef DUNE_SPGRID_DECOMPOSITIONREPORT_HH
+#define DUNE_SPGRID_DECOMPOSITIONREPORT_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <array>
+#include <ostream>
+
+#include <dune/grid/common/gridenums.hh>
+
+#include <dune/grid/spgrid/direction.hh>
+#include <dune/grid/spgrid/gridlevel.hh>
+
+namespace Dune
+{
+
+  // SPDecompositionReport
+  // ---------------------
+
+  /**
+   * \brief quality of the decomposition of a grid level
+   *
+   * The local quantities (volumes of the partitions, neighbor links and
+   * entities sent through each communication interface) are evaluated on
+   * construction. The global statistics are computed through the
+   * communicator of the grid, i.e., all methods returning Statistics are
+   * collective.
+   *
+   * \note Constructing a report builds all communication interfaces of the
+   *       grid level.
+   */
+  template< class Grid >
+  class SPDecompositionReport
+  {
+    typedef SPDecompositionReport< Grid > This;
+
+  public:
+    static const int dimension = Grid::dimension;
+
+    typedef SPGridLevel< Grid > GridLevel;
+
+    typedef typename GridLevel::PartitionList PartitionList;
+    typedef typename GridLevel::CommInterface CommInterface;
+
+    /** \brief minimum, maximum, sum and average of a quantity over all ranks */
+    struct Statistics
+    {
+      double min, max, sum, average;
+
+      /** \brief ratio of maximum to average (1 means perfectly balanced) */
+      double imbalance () const { return (average > 0 ? max / average : 1.0); }
+    };
+
+    explicit SPDecompositionReport ( const GridLevel &gridLevel );
+
+    /** \brief report on the leaf level of a grid */
+    explicit SPDecompositionReport ( const Grid &grid ) : This( grid.leafLevel() ) {}
+
+    SPDecompositionReport ( const Grid &grid, int level ) : This( grid.gridLevel( level ) ) {}
+
+    const GridLevel &gridLevel () const { return *gridLevel_; }
+
+    /** \brief number of interior cells */
+    std::size_t interiorVolume () const { return interiorVolume_; }
+
+    /** \brief number of overlap cells */
+    std::size_t overlapVolume () const { return overlapVolume_; }
+
+    /** \brief number of neighbor ranks linked by an interface */
+    std::size_t links ( InterfaceType iftype ) const { return interface( iftype ).links; }
+
+    /** \brief number of entities of a codimension sent through an interface */
+    std::size_t entities ( InterfaceType iftype, int codim ) const { return interface( iftype ).entities[ codim ]; }
+
+    /** \brief number of bytes sent through an interface, given the data size per entity of each codimension */
+    std::size_t bytes ( InterfaceType iftype, const std::array< std::size_t, dimension+1 > &size ) const;
+
+    Statistics interiorVolumeStatistics () const { return statistics( interiorVolume() ); }
+    Statistics overlapVolumeStatistics () const { return statistics( overlapVolume() ); }
+    Statistics linksStatistics ( InterfaceType iftype ) const { return statistics( links( iftype ) ); }
+    Statistics entitiesStatistics ( InterfaceType iftype, int codim ) const { return statistics( entities( iftype, codim ) ); }
+
+    Statistics bytesStatistics ( InterfaceType iftype, const std::array< std::size_t, dimension+1 > &size ) const
+    {
+      return statistics( bytes( iftype, size ) );
+    }
+
+    /** \brief compute global statistics of a local quantity (collective) */
+    Statistics statistics ( double value ) const;
+
+    /** \brief print global statistics of all quantities (collective) */
+    template< class char_type, class traits >
+    void print ( std::basic_ostream< char_type, traits > &out ) const;
+
+  private:
+    struct Interface
+    {
+      std::size_t links = 0;
+      std::array< std::size_t, dimension+1 > entities = {};
+    };
+
+    const Interface &interface ( InterfaceType iftype ) const;
+
+    static std::size_t count ( const PartitionList &partitionList, int codim );
+
+    const GridLevel *gridLevel_;
+    std::size_t interiorVolume_;
+    std::size_t overlapVolume_;
+
+    // note: We use the knowledge that interfaces are numbered 0, ..., 4.
+    std::array< Interface, 5 > interfaces_;
+  };
+
+
+
+  // Implementation of SPDecompositionReport
+  // ---------------------------------------
+
+  template< class Grid >
+  inline SPDecompositionReport< Grid >::SPDecompositionReport ( const GridLevel &gridLevel )
+    : gridLevel_( &gridLevel )
+  {
+    const long interiorVolume = gridLevel.template partition< Interior_Partition >().volume();
+    interiorVolume_ = interiorVolume;
+    overlapVolume_ = gridLevel.template partition< Overlap_Partition >().volume() - interiorVolume;
+
+    for( int iftype = 0; iftype < 5; ++iftype )
+    {
+      const CommInterface &commInterface = gridLevel.commInterface( InterfaceType( iftype ) );
+      Interface &interface = interfaces_[ iftype ];
+      interface.links = commInterface.size();
+      for( const auto &node : commInterface )
+      {
+        for( int codim = 0; codim <= dimension; ++codim )
+          interface.entities[ codim ] += count( node.sendList(), codim );
+      }
+    }
+  }
+
+
+  template< class Grid >
+  inline std::size_t SPDecompositionReport< Grid >
+    ::bytes ( InterfaceType iftype, const std::array< std::size_t, dimension+1 > &size ) const
+  {
+    std::size_t bytes = 0;
+    for( int codim = 0; codim <= dimension; ++codim )
+      bytes += entities( iftype, codim ) * size[ codim ];
+    return bytes;
+  }
+
+
+  template< class Grid >
+  inline typename SPDecompositionReport< Grid >::Statistics
+  SPDecompositionReport< Grid >::statistics ( double value ) const
+  {
+    const auto &comm = gridLevel().grid().comm();
+
+    Statistics statistics;
+    statistics.min = comm.min( value );
+    statistics.max = comm.max( value );
+    statistics.sum = comm.sum( value );
+    statistics.average = statistics.sum / comm.size();
+    return statistics;
+  }
+
+
+  template< class Grid >
+  template< class char_type, class traits >
+  inline void SPDecompositionReport< Grid >
+    ::print ( std::basic_ostream< char_type, traits > &out ) const
+  {
+    auto printStatistics = [ &out ] ( const char *name, const Statistics &statistics ) {
+        out << name << ": min = " << statistics.min << ", max = " << statistics.max
+            << ", avg = " << statistics.average << ", imbalance = " << statistics.imbalance() << std::endl;
+      };
+
+    out << "Decomposition of level " << gridLevel().level()
+        << " into " << gridLevel().grid().comm().size() << " ranks" << std::endl;
+    printStatistics( "interior volume", interiorVolumeStatistics() );
+    printStatistics( "overlap volume", overlapVolumeStatistics() );
+
+    const char *names[ 5 ] = { "InteriorBorder_InteriorBorder", "InteriorBorder_All", "Overlap_OverlapFront", "Overlap_All", "All_All" };
+    for( int iftype = 0; iftype < 5; ++iftype )
+    {
+      out << names[ iftype ] << "_Interface:" << std::endl;
+      printStatistics( "  links", linksStatistics( InterfaceType( iftype ) ) );
+      for( int codim = 0; codim <= dimension; ++codim )
+      {
+        out << "  codim " << codim << " ";
+        printStatistics( "entities", entitiesStatistics( InterfaceType( iftype ), codim ) );
+      }
+    }
+  }
+
+
+  template< class Grid >
+  inline const typename SPDecompositionReport< Grid >::Interface &
+  SPDecompositionReport< Grid >::interface ( InterfaceType iftype ) const
+  {
+    assert( (int( iftype ) >= 0) && (int( iftype ) < 5) );
+    return interfaces_[ int( iftype ) ];
+  }
+
+
+  template< class Grid >
+  inline std::size_t SPDecompositionReport< Grid >
+    ::count ( const PartitionList &partitionList, int codim )
+  {
+    std::size_t count = 0;
+    for( typename PartitionList::Iterator it = partitionList.begin(); it; ++it )
+    {
+      for( unsigned long bits = 0; bits < (1ul << dimension); ++bits )
+      {
+        const SPDirection< dimension > dir( bits );
+        if( (dir.codimension() != codim) || it->empty( dir ) )
+          continue;
+
+        // note: bound( b, i, d ) is the first (resp. last) coordinate of parity d
+        std::size_t size = 1;
+        for( int i = 0; i < dimension; ++i )
+          size *= std::size_t( (it->bound( 1, i, dir[ i ] ) - it->bound( 0, i, dir[ i ] )) / 2 + 1 );
+        count += size;
+      }
+    }
+    return count;
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_DECOMPOSITIONREPORT_HH
@@ -1,6 +1,10 @@
 #ifndef DUNE_SPGRID_DGFPARSER_HH
 #define DUNE_SPGRID_DGFPARSER_HH
 
+#include <algorithm>
+#include <cctype>
+#include <string>
+
 #include <dune/grid/io/file/dgfparser/dgfparser.hh>
 #include <dune/grid/spgrid.hh>
 
@@ -26,8 +30,28 @@ namespace Dune
         return overlap_;
       }
 
+      /** \brief use a processor grid decomposition instead of recursive bisection */
+      bool processorGrid () const
+      {
+        return processorGrid_;
+      }
+
+      /** \brief decompose among shared memory nodes first */
+      bool nodeAware () const
+      {
+        return nodeAware_;
+      }
+
+      /** \brief number of blocks per direction in the processor grid (0 = free) */
+      const MultiIndex &partitions () const
+      {
+        return partitions_;
+      }
+
     private:
       MultiIndex overlap_;
+      bool processorGrid_, nodeAware_;
+      MultiIndex partitions_;
     };
 
 
@@ -65,6 +89,46 @@ namespace Dune
       }
       else
         dwarn << "GridParameterBlock: Parameter 'overlap' not specified, defaulting to no overlap." << std::endl;
+
+      processorGrid_ = nodeAware_ = false;
+      for( int i = 0; i < dim; ++i )
+        partitions_[ i ] = 0;
+
+      bool bisection = false;
+      if( findtoken( "decomposition" ) )
+      {
+        std::string type;
+        if( !getnextentry( type ) )
+          DUNE_THROW( DGFException, "Found keyword 'decomposition' without valid value." );
+        std::transform( type.begin(), type.end(), type.begin(), [] ( char c ) { return std::tolower( c ); } );
+        if( type == "grid" )
+          processorGrid_ = true;
+        else if( type == "node" )
+          nodeAware_ = true;
+        else if( type == "bisection" )
+          bisection = true;
+        else
+          DUNE_THROW( DGFException, "Invalid decomposition '" << type << "' specified (use 'bisection', 'grid', or 'node')." );
+      }
+
+      if( findtoken( "partitions" ) )
+      {
+        int i = 0;
+        for( int x; getnextentry( x ); ++i )
+        {
+          if( x < 0 )
+            DUNE_THROW( DGFException, "Negative number of partitions specified." );
+          if( i < dim )
+            partitions_[ i ] = x;
+        }
+        if( i != dim )
+          DUNE_THROW( DGFException, "Invalid argument for parameter 'partitions' specified." );
+        if( nodeAware_ )
+          DUNE_THROW( DGFException, "Parameter 'partitions' cannot be combined with node-aware decomposition." );
+        if( bisection )
+          DUNE_THROW( DGFException, "Parameter 'partitions' cannot be combined with bisection decomposition." );
+        processorGrid_ = true;
+      }
     }
 
   } // namespace dgf
@@ -74,11 +138,11 @@ namespace Dune
   // DGFGridFactory< SPGrid >
   // ------------------------
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  class DGFGridFactory< SPGrid< ct, dim, Ref, Comm > >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  class DGFGridFactory< SPGrid< ct, dim, Ref, Comm, Index > >
   {
   public:
-    typedef SPGrid< ct, dim, Ref, Comm > Grid;
+    typedef SPGrid< ct, dim, Ref, Comm, Index > Grid;
 
     typedef MPIHelper::MPICommunicator MPICommunicatorType;
     typedef typename Grid::Communication Communication;
@@ -182,16 +246,16 @@ namespace Dune
   // Implementation of DGFGridFactory< SPGrid >
   // ------------------------------------------
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline DGFGridFactory< SPGrid< ct, dim, Ref, Comm > >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline DGFGridFactory< SPGrid< ct, dim, Ref, Comm, Index > >
     ::DGFGridFactory ( std::istream &input, MPICommunicatorType comm )
   {
     generate( input, SPCommunicationTraits< Comm >::comm( comm ) );
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline DGFGridFactory< SPGrid< ct, dim, Ref, Comm > >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline DGFGridFactory< SPGrid< ct, dim, Ref, Comm, Index > >
     ::DGFGridFactory ( const std::string &filename, MPICommunicatorType comm )
   {
     std::ifstream input( filename.c_str() );
@@ -202,9 +266,9 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
   inline void
-  DGFGridFactory< SPGrid< ct, dim, Ref, Comm > >
+  DGFGridFactory< SPGrid< ct, dim, Ref, Comm, Index > >
     ::generate ( std::istream &input, const Communication &comm )
   {
     dgf::IntervalBlock intervalBlock( input );
@@ -270,7 +334,20 @@ namespace Dune
     std::vector< typename Domain::Cube > cubes;
     cubes.push_back( typename Domain::Cube( a, b ) );
     Domain domain( cubes, typename Domain::Topology( periodic ) );
-    grid_ = new Grid( domain, cells, parameter.overlap(), comm );
+    typedef typename Grid::Decomposition Decomposition;
+    typedef typename Grid::MultiIndex MultiIndex;
+    if( parameter.processorGrid() )
+    {
+      const Decomposition decomposition( MultiIndex( cells ), comm.size(), MultiIndex( parameter.partitions() ) );
+      grid_ = new Grid( domain, decomposition, parameter.overlap(), comm );
+    }
+    else if( parameter.nodeAware() )
+    {
+      const Decomposition decomposition( MultiIndex( cells ), SPCommunicationTraits< Comm >::sharedMemoryNodes( comm ) );
+      grid_ = new Grid( domain, decomposition, parameter.overlap(), comm );
+    }
+    else
+      grid_ = new Grid( domain, cells, parameter.overlap(), comm );
 
     boundaryDomainBlock_ = new BoundaryDomainBlock( input, dimension );
   }
@@ -280,10 +357,10 @@ namespace Dune
   // DGFGridInfo< SPGrid >
   // ---------------------
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  struct DGFGridInfo< SPGrid< ct, dim, Ref, Comm > >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  struct DGFGridInfo< SPGrid< ct, dim, Ref, Comm, Index > >
   {
-    typedef SPGrid< ct, dim, Ref, Comm > Grid;
+    typedef SPGrid< ct, dim, Ref, Comm, Index > Grid;
     typedef typename Grid::RefinementPolicy RefinementPolicy;
 
     static int refineStepsForHalf ( const RefinementPolicy &policy = RefinementPolicy() )
@@ -103,7 +103,7 @@ namespace Dune
       return gridLevel().template referenceCube< codim >().count( cd-codim );
     }
 
-    bool hasFather () const { return ((level() > 0) && entityInfo().hasFather()); }
+    bool hasFather () const { return ((level() > gridLevel().grid().minLevel()) && entityInfo().hasFather()); }
 
     Entity father () const
     {
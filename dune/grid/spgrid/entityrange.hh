@@ -0,0 +1,314 @@
+#ifndef DUNE_SPGRID_ENTITYRANGE_HH
+#define DUNE_SPGRID_ENTITYRANGE_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#endif // #if HAVE_TBB
+
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/gridview.hh>
+
+#include <dune/grid/spgrid/direction.hh>
+#include <dune/grid/spgrid/entity.hh>
+#include <dune/grid/spgrid/partitionlist.hh>
+
+namespace Dune
+{
+
+  // SPEntityRange
+  // -------------
+
+  /**
+   * \brief splittable range of the entities of a partition list
+   *
+   * The range consists of boxes of entities, each one belonging to a
+   * single partition and direction. It can be split into two halves of
+   * (almost) equal size without touching the entities, so it satisfies the
+   * range concept of tbb::parallel_for. For OpenMP taskloops or parallel
+   * STL algorithms, chunks( n ) divides the range into n subranges.
+   *
+   * Within each box, the entities are visited lexicographically.
+   */
+  template< int codim, class Grid >
+  class SPEntityRange
+  {
+    typedef SPEntityRange< codim, Grid > This;
+
+    typedef SPEntity< codim, std::remove_const< Grid >::type::dimension, Grid > EntityImpl;
+
+  public:
+    typedef typename std::remove_const< Grid >::type::Traits Traits;
+
+    static const int dimension = Traits::ReferenceCube::dimension;
+    static const int codimension = codim;
+
+    typedef typename Traits::template Codim< codimension >::Entity Entity;
+
+    typedef typename EntityImpl::EntityInfo EntityInfo;
+    typedef typename EntityImpl::GridLevel GridLevel;
+
+    typedef typename EntityInfo::MultiIndex MultiIndex;
+
+    typedef SPPartitionList< dimension > PartitionList;
+
+    class Iterator;
+
+  private:
+    struct Box
+    {
+      std::size_t size () const
+      {
+        std::size_t size = 1;
+        for( int i = 0; i < dimension; ++i )
+          size *= width( i );
+        return size;
+      }
+
+      std::size_t width ( int i ) const { return std::size_t( (end[ i ] - begin[ i ]) / 2 + 1 ); }
+
+      unsigned int number;
+      MultiIndex begin, end;
+    };
+
+  public:
+    SPEntityRange ( const GridLevel &gridLevel, const PartitionList &partitionList, std::size_t grainSize = 1 );
+
+    /** \brief construct an empty range (see add) */
+    explicit SPEntityRange ( const GridLevel &gridLevel, std::size_t grainSize = 1 )
+      : This( &gridLevel, std::max( grainSize, std::size_t( 1 ) ) )
+    {}
+
+#if HAVE_TBB
+    /** \brief splitting constructor for tbb::parallel_for (this gets the upper half) */
+    SPEntityRange ( This &other, tbb::split ) : This( other.split() ) {}
+#endif // #if HAVE_TBB
+
+    Iterator begin () const { return Iterator( *this, 0 ); }
+    Iterator end () const { return Iterator( *this, boxes_.size() ); }
+
+    bool empty () const { return (size() == 0); }
+
+    /** \brief number of entities in this range */
+    std::size_t size () const { return size_; }
+
+    std::size_t grainSize () const { return grainSize_; }
+
+    bool is_divisible () const { return (size() > grainSize()) && ((boxes_.size() > 1) || (size() > 1)); }
+
+    /** \brief remove the upper half of this range and return it */
+    This split ();
+
+    /** \brief split this range into (at most) n subranges of almost equal size */
+    std::vector< This > chunks ( std::size_t n ) const;
+
+    const GridLevel &gridLevel () const { assert( gridLevel_ ); return *gridLevel_; }
+
+    /** \brief append the entities with ids in [ begin, end ] (inclusive) of a partition */
+    void add ( unsigned int number, const MultiIndex &begin, const MultiIndex &end )
+    {
+      Box box;
+      box.number = number;
+      box.begin = begin;
+      box.end = end;
+      push_back( box );
+    }
+
+  private:
+    SPEntityRange ( const GridLevel *gridLevel, std::size_t grainSize )
+      : gridLevel_( gridLevel ), size_( 0 ), grainSize_( grainSize )
+    {}
+
+    void push_back ( const Box &box );
+
+    const GridLevel *gridLevel_;
+    std::vector< Box > boxes_;
+    std::size_t size_;
+    std::size_t grainSize_;
+  };
+
+
+
+  // SPEntityRange::Iterator
+  // -----------------------
+
+  template< int codim, class Grid >
+  class SPEntityRange< codim, Grid >::Iterator
+  {
+    typedef typename SPEntityRange< codim, Grid >::Iterator This;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename SPEntityRange< codim, Grid >::Entity value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef value_type reference;
+
+    Iterator () = default;
+
+    Iterator ( const SPEntityRange< codim, Grid > &range, std::size_t box )
+      : range_( &range ), box_( box )
+    {
+      if( box_ < range.boxes_.size() )
+        id_ = range.boxes_[ box_ ].begin;
+      else
+        std::fill( id_.begin(), id_.end(), std::numeric_limits< int >::max() );
+    }
+
+    value_type operator* () const
+    {
+      return EntityImpl( EntityInfo( range_->gridLevel(), id_, range_->boxes_[ box_ ].number ) );
+    }
+
+    bool operator== ( const This &other ) const { return (box_ == other.box_) && (id_ == other.id_); }
+    bool operator!= ( const This &other ) const { return !(*this == other); }
+
+    This &operator++ ()
+    {
+      const Box &box = range_->boxes_[ box_ ];
+      for( int i = 0; i < dimension; ++i )
+      {
+        id_[ i ] += 2;
+        if( id_[ i ] <= box.end[ i ] )
+          return *this;
+        id_[ i ] = box.begin[ i ];
+      }
+      *this = Iterator( *range_, box_+1 );
+      return *this;
+    }
+
+    This operator++ ( int ) { This copy( *this ); ++(*this); return copy; }
+
+  private:
+    const SPEntityRange< codim, Grid > *range_ = nullptr;
+    std::size_t box_ = 0;
+    MultiIndex id_;
+  };
+
+
+
+  // Implementation of SPEntityRange
+  // -------------------------------
+
+  template< int codim, class Grid >
+  inline SPEntityRange< codim, Grid >
+    ::SPEntityRange ( const GridLevel &gridLevel, const PartitionList &partitionList, std::size_t grainSize )
+    : gridLevel_( &gridLevel ), size_( 0 ), grainSize_( std::max( grainSize, std::size_t( 1 ) ) )
+  {
+    for( typename PartitionList::Iterator it = partitionList.begin(); it; ++it )
+    {
+      for( SPDirectionIterator< dimension, codimension > dirIt; dirIt; ++dirIt )
+      {
+        const typename EntityInfo::Direction dir = *dirIt;
+        if( it->empty( dir ) )
+          continue;
+
+        MultiIndex begin, end;
+        for( int i = 0; i < dimension; ++i )
+        {
+          begin[ i ] = it->bound( 0, i, dir[ i ] );
+          end[ i ] = it->bound( 1, i, dir[ i ] );
+        }
+        add( it->number(), begin, end );
+      }
+    }
+  }
+
+
+  template< int codim, class Grid >
+  inline typename SPEntityRange< codim, Grid >::This SPEntityRange< codim, Grid >::split ()
+  {
+    assert( is_divisible() );
+
+    This upper( gridLevel_, grainSize_ );
+    if( boxes_.size() > 1 )
+    {
+      // keep the boxes covering the lower half (but at least one)
+      std::size_t k = 1;
+      for( std::size_t lowerSize = boxes_[ 0 ].size(); (k+1 < boxes_.size()) && (2*(lowerSize + boxes_[ k ].size()) <= size()); ++k )
+        lowerSize += boxes_[ k ].size();
+
+      for( std::size_t j = k; j < boxes_.size(); ++j )
+        upper.push_back( boxes_[ j ] );
+      boxes_.resize( k );
+      size_ -= upper.size();
+    }
+    else
+    {
+      // cut the only box across its widest axis
+      Box &box = boxes_.front();
+      int axis = 0;
+      for( int i = 1; i < dimension; ++i )
+        axis = (box.width( i ) > box.width( axis ) ? i : axis);
+
+      Box upperBox = box;
+      upperBox.begin[ axis ] = box.begin[ axis ] + 2*int( box.width( axis ) / 2 );
+      box.end[ axis ] = upperBox.begin[ axis ] - 2;
+
+      upper.push_back( upperBox );
+      size_ = box.size();
+    }
+    return upper;
+  }
+
+
+  template< int codim, class Grid >
+  inline std::vector< typename SPEntityRange< codim, Grid >::This >
+  SPEntityRange< codim, Grid >::chunks ( std::size_t n ) const
+  {
+    // note: always split the largest chunk, so the chunks stay balanced
+    std::vector< This > chunks( 1, *this );
+    while( chunks.size() < n )
+    {
+      std::size_t k = 0;
+      for( std::size_t j = 1; j < chunks.size(); ++j )
+        k = (chunks[ j ].size() > chunks[ k ].size() ? j : k);
+      if( !chunks[ k ].is_divisible() )
+        break;
+      chunks.push_back( chunks[ k ].split() );
+    }
+    return chunks;
+  }
+
+
+  template< int codim, class Grid >
+  inline void SPEntityRange< codim, Grid >::push_back ( const Box &box )
+  {
+    boxes_.push_back( box );
+    size_ += box.size();
+  }
+
+
+
+  // entityRange
+  // -----------
+
+  /**
+   * \brief splittable range of the entities of a grid view
+   *
+   * \code
+   * tbb::parallel_for( entityRange< 0, Interior_Partition >( gridView, 1024 ), [] ( const auto &range ) {
+   *     for( const auto &element : range )
+   *       ...
+   *   } );
+   * \endcode
+   */
+  template< int codim, PartitionIteratorType pitype = All_Partition, class ViewTraits >
+  inline SPEntityRange< codim, const typename ViewTraits::Grid >
+  entityRange ( const GridView< ViewTraits > &gridView, std::size_t grainSize = 1 )
+  {
+    const auto &gridLevel = gridView.impl().gridLevel();
+    return SPEntityRange< codim, const typename ViewTraits::Grid >( gridLevel, gridLevel.template partition< pitype >(), grainSize );
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_ENTITYRANGE_HH
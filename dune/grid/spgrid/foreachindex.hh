@@ -0,0 +1,464 @@
+#ifndef DUNE_SPGRID_FOREACHINDEX_HH
+#define DUNE_SPGRID_FOREACHINDEX_HH
+
+#include <cstddef>
+
+#include <algorithm>
+#include <type_traits>
+
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/gridview.hh>
+
+#include <dune/grid/spgrid/declaration.hh>
+#include <dune/grid/spgrid/direction.hh>
+#include <dune/grid/spgrid/gridlevel.hh>
+#include <dune/grid/spgrid/indexset.hh>
+#include <dune/grid/spgrid/multiindex.hh>
+#include <dune/grid/spgrid/ordering.hh>
+#include <dune/grid/spgrid/partitionlist.hh>
+
+namespace Dune
+{
+
+  namespace __SPGrid
+  {
+
+    // IsLexicographic
+    // ---------------
+
+    template< class IndexSet >
+    struct IsLexicographic
+      : public std::false_type
+    {};
+
+    template< class Grid, PartitionIteratorType pitype >
+    struct IsLexicographic< SPIndexSet< Grid, SPLexicographicOrdering, pitype > >
+      : public std::true_type
+    {};
+
+
+
+    // forEachRow
+    // ----------
+
+    /**
+     * \brief call f( number, id, count ) for each row of entities of a partition list
+     *
+     * A row consists of the count entities id, id + 2 e_0, ..., i.e., it
+     * extends along the first axis.
+     */
+    template< int codim, int dim, class F >
+    inline void forEachRow ( const SPPartitionList< dim > &partitionList, F &&f )
+    {
+      typedef SPPartitionList< dim > PartitionList;
+      typedef typename PartitionList::MultiIndex MultiIndex;
+
+      for( typename PartitionList::Iterator pit = partitionList.begin(); pit; ++pit )
+      {
+        for( SPDirectionIterator< dim, codim > dirIt; dirIt; ++dirIt )
+        {
+          const SPDirection< dim > dir = *dirIt;
+          if( pit->empty( dir ) )
+            continue;
+
+          MultiIndex begin, end;
+          for( int i = 0; i < dim; ++i )
+          {
+            begin[ i ] = pit->bound( 0, i, dir[ i ] );
+            end[ i ] = pit->bound( 1, i, dir[ i ] );
+          }
+
+          const int count = (end[ 0 ] - begin[ 0 ]) / 2 + 1;
+          for( MultiIndex id = begin; true; )
+          {
+            f( pit->number(), id, count );
+
+            int i = 1;
+            for( ; i < dim; ++i )
+            {
+              id[ i ] += 2;
+              if( id[ i ] <= end[ i ] )
+                break;
+              id[ i ] = begin[ i ];
+            }
+            if( i == dim )
+              break;
+          }
+        }
+      }
+    }
+
+  } // namespace __SPGrid
+
+
+
+  // forEachRow
+  // ----------
+
+  /**
+   * \brief call a kernel for each row of entities of a grid view
+   *
+   * The kernel is called as kernel( id, index, count ) for each row of count
+   * entities id, id + 2 e_0, ... along the first axis. Their indices (in the
+   * index set of the grid view) are index, index+1, ..., so the inner loop
+   * over a row is a contiguous loop the compiler can vectorize. No entities
+   * are constructed. The geometry of a row is provided by SPRowGeometry.
+   *
+   * \note Rows are only contiguous in the index set, if it uses the
+   *       lexicographic ordering.
+   */
+  template< int codim, PartitionIteratorType pitype = All_Partition, class ViewTraits, class Kernel >
+  inline void forEachRow ( const GridView< ViewTraits > &gridView, Kernel &&kernel )
+  {
+    typedef typename ViewTraits::IndexSet IndexSet;
+    static_assert( __SPGrid::IsLexicographic< IndexSet >::value, "forEachRow requires an index set with lexicographic ordering." );
+
+    const IndexSet &indexSet = gridView.indexSet();
+    const auto &partitionList = gridView.impl().gridLevel().template partition< pitype >();
+    __SPGrid::forEachRow< codim >( partitionList, [ &indexSet, &kernel ] ( unsigned int number, const auto &id, int count ) {
+        kernel( id, indexSet.index( id, number ), count );
+      } );
+  }
+
+
+
+  // forEachIndex
+  // ------------
+
+  /**
+   * \brief call a kernel for each entity of a grid view, without constructing it
+   *
+   * The kernel is called as kernel( id, index ), where id is the multi-index
+   * of the entity and index is its index in the index set of the grid view.
+   * The entities are visited in the same order as by the partition iterator.
+   * Geometric information can be obtained from an SPIndexGeometry.
+   */
+  template< int codim, PartitionIteratorType pitype = All_Partition, class ViewTraits, class Kernel >
+  inline void forEachIndex ( const GridView< ViewTraits > &gridView, Kernel &&kernel )
+  {
+    typedef typename ViewTraits::IndexSet IndexSet;
+    typedef typename IndexSet::IndexType IndexType;
+
+    const IndexSet &indexSet = gridView.indexSet();
+    const auto &partitionList = gridView.impl().gridLevel().template partition< pitype >();
+    __SPGrid::forEachRow< codim >( partitionList, [ &indexSet, &kernel ] ( unsigned int number, const auto &row, int count ) {
+        auto id = row;
+        if( __SPGrid::IsLexicographic< IndexSet >::value )
+        {
+          const IndexType first = indexSet.index( id, number );
+          for( int k = 0; k < count; ++k, id[ 0 ] += 2 )
+            kernel( id, first + IndexType( k ) );
+        }
+        else
+        {
+          for( int k = 0; k < count; ++k, id[ 0 ] += 2 )
+            kernel( id, indexSet.index( id, number ) );
+        }
+      } );
+  }
+
+
+
+  // SPFaceRun
+  // ---------
+
+  /**
+   * \brief run of consecutive faces with the same normal (see forEachFaceRun)
+   *
+   * Face k of the run (0 <= k < count) has the multi-index id + 2 k e_0 and
+   * the index face + k. Its inside (resp. outside) element, i.e., the
+   * element in negative (resp. positive) normal direction, has the index
+   * inside + k (resp. outside + k). Hence, all indices advance with stride
+   * one and flux kernels become plain array loops.
+   */
+  template< int dim, class IndexType >
+  struct SPFaceRun
+  {
+    SPMultiIndex< dim > id;
+    int count;
+    int axis;
+    bool boundary;
+    bool hasInside, hasOutside;
+    IndexType face, inside, outside;
+  };
+
+
+
+  // forEachFaceRun
+  // --------------
+
+  /**
+   * \brief call a kernel for each run of faces of a grid view
+   *
+   * The kernel is called as kernel( run ) with an SPFaceRun. Each face of
+   * the grid view is contained in exactly one run. Neighbors across periodic
+   * boundaries are resolved once per run, as are missing neighbors (on the
+   * domain boundary or the boundary of the All partition).
+   */
+  template< PartitionIteratorType pitype = All_Partition, class ViewTraits, class Kernel >
+  inline void forEachFaceRun ( const GridView< ViewTraits > &gridView, Kernel &&kernel )
+  {
+    typedef typename ViewTraits::IndexSet IndexSet;
+    static_assert( __SPGrid::IsLexicographic< IndexSet >::value, "forEachFaceRun requires an index set with lexicographic ordering." );
+
+    typedef typename IndexSet::IndexType IndexType;
+    typedef typename IndexSet::MultiIndex MultiIndex;
+    typedef SPFaceRun< IndexSet::dimension, IndexType > Run;
+
+    const IndexSet &indexSet = gridView.indexSet();
+    const auto &gridLevel = gridView.impl().gridLevel();
+    const auto &allList = gridLevel.template partition< All_Partition >();
+    const auto &globalMesh = gridLevel.globalMesh();
+
+    // find the element behind a face of a partition (cf. SPIntersection::outside)
+    auto element = [ &indexSet, &allList ] ( MultiIndex id, unsigned int number, int face, IndexType &index ) {
+        const int axis = face / 2;
+        const int sign = 2*(face & 1) - 1;
+        const auto &partition = allList.partition( number );
+        id[ axis ] += sign;
+        if( (id[ axis ] < partition.bound( 0, axis, 1 )) || (id[ axis ] > partition.bound( 1, axis, 1 )) )
+        {
+          if( !partition.hasNeighbor( face ) )
+            return false;
+          number = partition.neighbor( face );
+          const int bound = allList.partition( number ).bound( 1 - (face & 1) )[ axis ];
+          id[ axis ] = bound + sign*(1 - (bound & 1));
+        }
+        index = indexSet.index( id, number );
+        return true;
+      };
+
+    auto emit = [ &indexSet, &globalMesh, &element, &kernel ] ( unsigned int number, const MultiIndex &id, int axis, int count ) {
+        Run run;
+        run.id = id;
+        run.count = count;
+        run.axis = axis;
+        run.boundary = (id[ axis ] == 2*globalMesh.begin()[ axis ]) || (id[ axis ] == 2*globalMesh.end()[ axis ]);
+        run.face = indexSet.index( id, number );
+        run.hasInside = element( id, number, 2*axis, run.inside );
+        run.hasOutside = element( id, number, 2*axis+1, run.outside );
+        kernel( static_cast< const Run & >( run ) );
+      };
+
+    __SPGrid::forEachRow< 1 >( gridLevel.template partition< pitype >(), [ &allList, &emit ] ( unsigned int number, const MultiIndex &id, int count ) {
+        int axis = 0;
+        while( (id[ axis ] & 1) != 0 )
+          ++axis;
+        if( axis != 0 )
+          return emit( number, id, axis, count );
+
+        // for faces normal to the row, only the first and the last one can have irregular neighbors
+        const auto &partition = allList.partition( number );
+        const bool firstIrregular = (id[ 0 ] - 1 < partition.bound( 0, 0, 1 ));
+        const bool lastIrregular = (id[ 0 ] + 2*count - 1 > partition.bound( 1, 0, 1 ));
+        const int begin = (firstIrregular ? 1 : 0);
+        const int end = (lastIrregular ? count-1 : count);
+
+        MultiIndex first = id;
+        if( firstIrregular )
+          emit( number, first, 0, 1 );
+        first[ 0 ] += 2*begin;
+        if( begin < end )
+          emit( number, first, 0, end - begin );
+        first[ 0 ] = id[ 0 ] + 2*(count-1);
+        if( lastIrregular && (count-1 >= begin) )
+          emit( number, first, 0, 1 );
+      } );
+  }
+
+
+
+  // SPBoundaryRun
+  // -------------
+
+  /**
+   * \brief run of consecutive boundary faces (see forEachBoundaryRun)
+   *
+   * The run extends along the given axis, i.e., face k of the run
+   * (0 <= k < count) has the multi-index id + 2 k e_axis. Its index is
+   * face + k faceStride and its (only) element has the index
+   * element + k elementStride. As all faces within a macro face share their
+   * boundary segment, the boundary segment index of face k is
+   * segment + ((segmentPhase + k) / segmentFactor) segmentStride.
+   */
+  template< int dim, class IndexType >
+  struct SPBoundaryRun
+  {
+    SPMultiIndex< dim > id;
+    int count;
+    int axis;
+    IndexType face, faceStride;
+    IndexType element, elementStride;
+    std::size_t segment, segmentStride;
+    int segmentPhase, segmentFactor;
+  };
+
+
+
+  // forEachBoundaryRun
+  // ------------------
+
+  /**
+   * \brief call a kernel for each run of boundary faces on a face of the domain
+   *
+   * The kernel is called as kernel( run ) with an SPBoundaryRun for each
+   * row of faces in the boundary partition of the given face. Rows extend
+   * along the first axis tangential to the face. No intersections are
+   * constructed and the boundary segment index is only evaluated at most
+   * twice per run.
+   */
+  template< class ViewTraits, class Kernel >
+  inline void forEachBoundaryRun ( const GridView< ViewTraits > &gridView, int face, Kernel &&kernel )
+  {
+    typedef typename ViewTraits::IndexSet IndexSet;
+    typedef typename IndexSet::IndexType IndexType;
+    typedef typename IndexSet::MultiIndex MultiIndex;
+
+    const int dimension = IndexSet::dimension;
+    typedef SPBoundaryRun< dimension, IndexType > Run;
+
+    const IndexSet &indexSet = gridView.indexSet();
+    const auto &gridLevel = gridView.impl().gridLevel();
+
+    // the run axis is the first axis tangential to the face
+    const int normal = face / 2;
+    const int axis = (normal == 0 ? std::min( 1, dimension-1 ) : 0);
+    const int factor = gridLevel.macroFactor()[ axis ];
+
+    SPDirection< dimension > dir;
+    for( int i = 0; i < dimension; ++i )
+      dir[ i ] = (i != normal);
+
+    const auto &partitionList = gridLevel.boundaryPartition( face );
+    for( auto pit = partitionList.begin(); pit; ++pit )
+    {
+      if( pit->empty( dir ) )
+        continue;
+
+      MultiIndex begin, end;
+      for( int i = 0; i < dimension; ++i )
+      {
+        begin[ i ] = pit->bound( 0, i, dir[ i ] );
+        end[ i ] = pit->bound( 1, i, dir[ i ] );
+      }
+
+      const unsigned int number = pit->number();
+      Run run;
+      run.count = (axis != normal ? (end[ axis ] - begin[ axis ]) / 2 + 1 : 1);
+      run.axis = axis;
+      run.segmentFactor = factor;
+      for( run.id = begin; true; )
+      {
+        MultiIndex element = run.id;
+        element[ normal ] += 1 - 2*(face & 1);
+
+        run.face = indexSet.index( run.id, number );
+        run.element = indexSet.index( element, number );
+        run.segment = gridLevel.boundaryIndex( run.id, number, face );
+        run.segmentPhase = (run.id[ axis ] >> 1) % factor;
+        run.faceStride = run.elementStride = 0;
+        run.segmentStride = 0;
+        if( run.count > 1 )
+        {
+          MultiIndex next = run.id;
+          next[ axis ] += 2;
+          element[ axis ] += 2;
+          run.faceStride = indexSet.index( next, number ) - run.face;
+          run.elementStride = indexSet.index( element, number ) - run.element;
+        }
+        if( factor - run.segmentPhase < run.count )
+        {
+          MultiIndex next = run.id;
+          next[ axis ] += 2*(factor - run.segmentPhase);
+          run.segmentStride = gridLevel.boundaryIndex( next, number, face ) - run.segment;
+        }
+        kernel( static_cast< const Run & >( run ) );
+
+        int i = 0;
+        for( ; i < dimension; ++i )
+        {
+          if( i == axis )
+            continue;
+          run.id[ i ] += 2;
+          if( run.id[ i ] <= end[ i ] )
+            break;
+          run.id[ i ] = begin[ i ];
+        }
+        if( i == dimension )
+          break;
+      }
+    }
+  }
+
+  /** \brief call a kernel for each run of boundary faces (on all faces of the domain) */
+  template< class ViewTraits, class Kernel >
+  inline void forEachBoundaryRun ( const GridView< ViewTraits > &gridView, Kernel &&kernel )
+  {
+    for( int face = 0; face < 2*ViewTraits::IndexSet::dimension; ++face )
+      forEachBoundaryRun( gridView, face, kernel );
+  }
+
+
+
+  // SPIndexGeometry
+  // ---------------
+
+  /**
+   * \brief geometric information on entities given by their multi-index
+   *
+   * This class provides the geometric information needed within the kernels
+   * passed to forEachIndex or forEachRow. It only uses the mesh width and
+   * origin of the grid level.
+   */
+  template< class Grid >
+  class SPIndexGeometry
+  {
+    typedef SPIndexGeometry< Grid > This;
+
+  public:
+    typedef SPGridLevel< typename std::remove_const< Grid >::type > GridLevel;
+
+    static const int dimension = GridLevel::dimension;
+
+    typedef typename GridLevel::ctype ctype;
+    typedef typename GridLevel::GlobalVector GlobalVector;
+    typedef typename GridLevel::MultiIndex MultiIndex;
+
+    explicit SPIndexGeometry ( const GridLevel &gridLevel )
+      : h_( gridLevel.h() ), origin_( gridLevel.domain().cube().origin() )
+    {}
+
+    template< class ViewTraits >
+    explicit SPIndexGeometry ( const GridView< ViewTraits > &gridView )
+      : This( gridView.impl().gridLevel() )
+    {}
+
+    /** \brief mesh width of the grid level */
+    const GlobalVector &h () const { return h_; }
+
+    /** \brief lower left corner of the entity */
+    GlobalVector corner ( const MultiIndex &id ) const
+    {
+      GlobalVector corner = origin_;
+      for( int i = 0; i < dimension; ++i )
+        corner[ i ] += (id[ i ] / 2) * h_[ i ];
+      return corner;
+    }
+
+    /** \brief center of the entity */
+    GlobalVector center ( const MultiIndex &id ) const
+    {
+      GlobalVector center = origin_;
+      for( int i = 0; i < dimension; ++i )
+        center[ i ] += ctype( id[ i ] ) * ctype( 0.5 ) * h_[ i ];
+      return center;
+    }
+
+  private:
+    GlobalVector h_;
+    GlobalVector origin_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_FOREACHINDEX_HH
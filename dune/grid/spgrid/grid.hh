@@ -4,8 +4,13 @@
 #include <cstddef>
 
 #include <array>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include <dune/common/parallel/mpicommunication.hh>
 
@@ -22,6 +27,7 @@
 #include <dune/grid/spgrid/indexset.hh>
 #include <dune/grid/spgrid/hindexset.hh>
 #include <dune/grid/spgrid/fileio.hh>
+#include <dune/grid/spgrid/migration.hh>
 
 namespace Dune
 {
@@ -46,10 +52,10 @@ namespace Dune
   // -----------------------------
 
 #if HAVE_MPI
-  template< class ct, int dim, template< int > class Ref = SPIsotropicRefinement, class Comm = MPI_Comm >
+  template< class ct, int dim, template< int > class Ref = SPIsotropicRefinement, class Comm = MPI_Comm, class Index = unsigned int >
   class SPGrid;
 #else
-  template< class ct, int dim, template< int > class Ref = SPIsotropicRefinement, class Comm = No_Comm >
+  template< class ct, int dim, template< int > class Ref = SPIsotropicRefinement, class Comm = No_Comm, class Index = unsigned int >
   class SPGrid;
 #endif // #if !HAVE_MPI
 
@@ -58,12 +64,12 @@ namespace Dune
   // SPGridFamily
   // ------------
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
   struct SPGridFamily
   {
     struct Traits
     {
-      typedef SPGrid< ct, dim, Ref, Comm > Grid;
+      typedef SPGrid< ct, dim, Ref, Comm, Index > Grid;
 
       typedef SPReferenceCubeContainer< ct, dim > ReferenceCubeContainer;
       typedef typename ReferenceCubeContainer::ReferenceCube ReferenceCube;
@@ -83,6 +89,8 @@ namespace Dune
 
       typedef Dune::EntityIterator< 0, const Grid, SPHierarchicIterator< const Grid, 0 > > HierarchicIterator;
 
+      typedef Index IndexType;
+
       typedef SPIndexSet< const Grid > LevelIndexSet;
       typedef LevelIndexSet LeafIndexSet;
 
@@ -130,22 +138,25 @@ namespace Dune
    *  \tparam  dim       dimension of the grid
    *  \tparam  Ref       refinement (default is SPIsotropicRefinement)
    *  \tparam  Comm      type of communicator (default depends on HAVE_MPI)
+   *  \tparam  Index     type of indices and sizes (default is unsigned int,
+   *                     use std::uint64_t for more than 2^32 entities)
    */
-  template< class ct, int dim, template< int > class Ref, class Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
   class SPGrid
-    : public GridDefaultImplementation< dim, dim, ct, SPGridFamily< ct, dim, Ref, Comm > >
+    : public GridDefaultImplementation< dim, dim, ct, SPGridFamily< ct, dim, Ref, Comm, Index > >
   {
-    typedef SPGrid< ct, dim, Ref, Comm > This;
-    typedef GridDefaultImplementation< dim, dim, ct, SPGridFamily< ct, dim, Ref, Comm > > Base;
+    typedef SPGrid< ct, dim, Ref, Comm, Index > This;
+    typedef GridDefaultImplementation< dim, dim, ct, SPGridFamily< ct, dim, Ref, Comm, Index > > Base;
 
     friend struct BackupRestoreFacility< This >;
     friend class SPIntersection< const This >;
     friend class SPGridLevel< This >;
 
+    template< class > friend class SPLocalIdSet;
     template< class, class > friend class __SPGrid::TreeIterator;
 
   public:
-    typedef SPGridFamily< ct, dim, Ref, Comm > GridFamily;
+    typedef SPGridFamily< ct, dim, Ref, Comm, Index > GridFamily;
 
     typedef typename GridFamily::Traits Traits;
 
@@ -186,9 +197,14 @@ namespace Dune
 
     typedef SPHierarchyIndexSet< const This > HierarchicIndexSet;
 
+    /** \brief type of indices and sizes (see template parameter Index) */
+    typedef typename Traits::IndexType IndexType;
+
     typedef SPGridLevel< This > GridLevel;
 
+    typedef typename GridLevel::Decomposition Decomposition;
     typedef typename GridLevel::MultiIndex MultiIndex;
+    typedef SPTraversal< dimension > Traversal;
     static const int numDirections = GridLevel::numDirections;
 
   private:
@@ -197,6 +213,15 @@ namespace Dune
     typedef typename LevelGridView::Traits::GridViewImp LevelGridViewImpl;
     typedef typename LeafGridView::Traits::GridViewImp LeafGridViewImpl;
 
+    struct OrderedGridViewsBase
+    {
+      virtual ~OrderedGridViewsBase () = default;
+      virtual void update ( const This &grid ) = 0;
+    };
+
+    template< class Ordering >
+    struct OrderedGridViews;
+
   public:
     SPGrid ( const Domain &domain, const MultiIndex &cells,
              const Communication &comm = SPCommunicationTraits< Comm >::defaultComm() );
@@ -211,6 +236,19 @@ namespace Dune
              const MultiIndex &overlap,
              const Communication &comm = SPCommunicationTraits< Comm >::defaultComm() );
 
+    /**
+     * \brief construct grid from a given decomposition of the macro mesh
+     *
+     * \note The decomposition must consist of one sub-mesh per rank of the
+     *       communicator, e.g., a weighted SPDecomposition.
+     */
+    SPGrid ( const Domain &domain, const Decomposition &decomposition, const MultiIndex &overlap,
+             const Communication &comm = SPCommunicationTraits< Comm >::defaultComm() );
+
+    SPGrid ( const GlobalVector &a, const GlobalVector &b, const Decomposition &decomposition,
+             const MultiIndex &overlap,
+             const Communication &comm = SPCommunicationTraits< Comm >::defaultComm() );
+
     SPGrid ( const This & ) = delete;
     SPGrid ( This &&other );
 
@@ -229,101 +267,129 @@ namespace Dune
 
     const MultiIndex &overlap () const { return overlap_; }
 
+    const Decomposition &decomposition () const { return decomposition_; }
+
     int maxLevel () const
     {
       return leafLevel().level();
     }
 
-    int size ( const int level, const int codim ) const
+    /** \brief coarsest level not discarded (see discardCoarseLevels) */
+    int minLevel () const { return minLevel_; }
+
+    IndexType size ( const int level, const int codim ) const
     {
-      return levelGridView( level ).size( codim );
+      return levelGridView( level ).impl().size( codim );
     }
 
-    int size ( const int codim ) const
+    IndexType size ( const int codim ) const
     {
-      return leafGridView().size( codim );
+      return leafGridView().impl().size( codim );
     }
 
-    int size ( const int level, const GeometryType &type ) const
+    IndexType size ( const int level, const GeometryType &type ) const
     {
-      return levelGridView( level ).size( type );
+      return levelGridView( level ).impl().size( type );
     }
 
-    int size ( const GeometryType &type ) const
+    IndexType size ( const GeometryType &type ) const
     {
-      return leafGridView().size( type );
+      return leafGridView().impl().size( type );
     }
 
     LevelGridView levelGridView ( int level ) const
     {
-      assert( (level >= 0) && (level <= maxLevel()) );
+      assert( (level >= minLevel()) && (level <= maxLevel()) );
       return levelGridViews_[ level ];
     }
 
     LeafGridView leafGridView () const { return leafGridView_; }
 
+    /**
+     * \brief level grid view numbering the entities in a different order
+     *
+     * \tparam  Ordering  ordering of the index set, e.g., SPMortonOrdering
+     *
+     * The grid views of each ordering are built on first request and cached
+     * by the grid. Like the default grid views, they are updated by
+     * globalRefine, loadBalance and discardCoarseLevels.
+     */
+    template< class Ordering >
+    Dune::GridView< SPGridViewTraits< const This, Ordering > > levelGridView ( int level ) const
+    {
+      assert( (level >= minLevel()) && (level <= maxLevel()) );
+      return orderedGridViews< Ordering >().levelGridViews[ level ];
+    }
+
+    /** \brief leaf grid view numbering the entities in a different order */
+    template< class Ordering >
+    Dune::GridView< SPGridViewTraits< const This, Ordering > > leafGridView () const
+    {
+      return orderedGridViews< Ordering >().leafGridView;
+    }
+
     template< int codim, PartitionIteratorType pitype >
     typename Traits::template Codim< codim >::template Partition< pitype >::LevelIterator
-    lbegin ( const int level, const unsigned int sweepDir = 0 ) const
+    lbegin ( const int level, const Traversal &traversal = Traversal() ) const
     {
       const LevelGridView &view = levelGridView( level );
-      return view.impl().template begin< codim, pitype >( sweepDir );
+      return view.impl().template begin< codim, pitype >( traversal );
     }
 
     template< int codim, PartitionIteratorType pitype >
     typename Traits::template Codim< codim >::template Partition< pitype >::LevelIterator
-    lend ( const int level, const unsigned int sweepDir = 0 ) const
+    lend ( const int level, const Traversal &traversal = Traversal() ) const
     {
       const LevelGridView &view = levelGridView( level );
-      return view.impl().template end< codim, pitype >( sweepDir );
+      return view.impl().template end< codim, pitype >( traversal );
     }
 
     template< int codim >
     typename Traits::template Codim< codim >::LevelIterator
-    lbegin ( const int level, const unsigned int sweepDir = 0 ) const
+    lbegin ( const int level, const Traversal &traversal = Traversal() ) const
     {
       const LevelGridView &view = levelGridView( level );
-      return view.impl().template begin< codim >( sweepDir );
+      return view.impl().template begin< codim >( traversal );
     }
 
     template< int codim >
     typename Traits::template Codim< codim >::LevelIterator
-    lend ( const int level, const unsigned int sweepDir = 0 ) const
+    lend ( const int level, const Traversal &traversal = Traversal() ) const
     {
       const LevelGridView &view = levelGridView( level );
-      return view.impl().template end< codim >( sweepDir );
+      return view.impl().template end< codim >( traversal );
     }
 
     template< int codim, PartitionIteratorType pitype >
     typename Traits::template Codim< codim >::template Partition< pitype >::LeafIterator
-    leafbegin ( const unsigned int sweepDir = 0 ) const
+    leafbegin ( const Traversal &traversal = Traversal() ) const
     {
       const LeafGridView &view = leafGridView();
-      return view.impl().template begin< codim, pitype >( sweepDir );
+      return view.impl().template begin< codim, pitype >( traversal );
     }
 
     template< int codim, PartitionIteratorType pitype >
     typename Traits::template Codim< codim >::template Partition< pitype >::LeafIterator
-    leafend ( const unsigned int sweepDir = 0 ) const
+    leafend ( const Traversal &traversal = Traversal() ) const
     {
       const LeafGridView &view = leafGridView();
-      return view.impl().template end< codim, pitype >( sweepDir );
+      return view.impl().template end< codim, pitype >( traversal );
     }
 
     template< int codim >
     typename Traits::template Codim< codim >::LeafIterator
-    leafbegin ( const unsigned int sweepDir = 0 ) const
+    leafbegin ( const Traversal &traversal = Traversal() ) const
     {
       const LeafGridView &view = leafGridView();
-      return view.impl().template begin< codim >( sweepDir );
+      return view.impl().template begin< codim >( traversal );
     }
 
     template< int codim >
     typename Traits::template Codim< codim >::LeafIterator
-    leafend ( const unsigned int sweepDir = 0 ) const
+    leafend ( const Traversal &traversal = Traversal() ) const
     {
       const LeafGridView &view = leafGridView();
-      return view.impl().template end< codim >( sweepDir );
+      return view.impl().template end< codim >( traversal );
     }
 
     const GlobalIdSet &globalIdSet () const
@@ -363,6 +429,12 @@ namespace Dune
 
     void postAdapt ();
 
+    /**
+     * \brief refine the leaf level refCount times
+     *
+     * A negative refCount removes the -refCount finest levels instead. The
+     * coarsest level is never removed.
+     */
     void globalRefine ( const int refCount,
                         const RefinementPolicy &policy = RefinementPolicy() );
 
@@ -371,6 +443,57 @@ namespace Dune
                         AdaptDataHandleInterface< This, DataHandle > &handle,
                         const RefinementPolicy &policy = RefinementPolicy() );
 
+    /**
+     * \brief discard all levels below a given one
+     *
+     * The partition pools, communication interfaces and index sets of the
+     * discarded levels are released. Ids of the remaining entities are not
+     * changed, but the hierarchic index set only enumerates the remaining
+     * levels, i.e., persistent containers have to be refilled. Entities on
+     * the new coarsest level have no father.
+     *
+     * \note Level grid views of discarded levels must not be used anymore.
+     */
+    void discardCoarseLevels ( int level );
+
+    /**
+     * \brief redistribute the grid according to a new decomposition
+     *
+     * All grid levels are rebuilt on the new decomposition of the macro mesh
+     * (replaying their refinement policies). The decomposition must be the
+     * same on all ranks, e.g., a weighted SPDecomposition using global
+     * weights.
+     *
+     * For each level, the data attached to the InteriorBorder entities is
+     * gathered on the old grid and scattered to the All entities of the new
+     * grid. Use SPPersistentContainerDataHandle to migrate a
+     * PersistentContainer. If the data handle provides a method resize(), it
+     * is called once after the grid has been rebuilt and before any data is
+     * scattered.
+     *
+     * \note All entities, iterators and indices are invalidated.
+     *
+     * \returns \b true, if the decomposition has changed
+     */
+    template< class DataHandle, class Data >
+    bool loadBalance ( const Decomposition &decomposition, CommDataHandleIF< DataHandle, Data > &dataHandle );
+
+    /** \brief redistribute the grid, balancing the number of macro cells */
+    template< class DataHandle, class Data >
+    bool loadBalance ( CommDataHandleIF< DataHandle, Data > &dataHandle )
+    {
+      return loadBalance( Decomposition( globalMesh_, comm().size() ), dataHandle );
+    }
+
+    /** \brief redistribute the grid without migrating any data */
+    bool loadBalance ( const Decomposition &decomposition );
+
+    /** \brief redistribute the grid, balancing the number of macro cells */
+    bool loadBalance ()
+    {
+      return loadBalance( Decomposition( globalMesh_, comm().size() ) );
+    }
+
     int overlapSize ( const int level, const int codim ) const
     {
       return levelGridView( level ).overlapSize( codim );
@@ -424,12 +547,12 @@ namespace Dune
     template< int codim >
     bool hasFather ( const Dune::Entity< codim, dimension, const This, SPEntity > &entity ) const
     {
-      return ((entity.level() > 0) && entity.impl().entityInfo().hasFather());
+      return ((entity.level() > minLevel()) && entity.impl().entityInfo().hasFather());
     }
 
     bool hasFather ( const Dune::Intersection< const This, SPIntersection< const This > > &intersection ) const
     {
-      return ((intersection.impl().gridLevel().level() > 0) && intersection.impl().entityInfo().hasFather());
+      return ((intersection.impl().gridLevel().level() > minLevel()) && intersection.impl().entityInfo().hasFather());
     }
 
     template< int codim >
@@ -469,6 +592,10 @@ namespace Dune
                            const unsigned int partitionNumber,
                            const int face ) const;
 
+    // note: these methods also work for discarded levels
+    const Refinement &refinement ( int level ) const;
+    const Mesh &globalMesh ( int level ) const;
+
     typename Codim< 1 >::LocalGeometry localFaceGeometry ( int face ) const
     {
       assert( (face >= 0) && (face < ReferenceCube::numFaces) );
@@ -476,22 +603,35 @@ namespace Dune
     }
 
     void createLocalGeometries ();
+    void checkDecomposition ( const Decomposition &decomposition ) const;
+    std::vector< std::unique_ptr< GridLevel > > makeGridLevels ( const Decomposition &decomposition ) const;
+    void setupGridLevels ( const Decomposition &decomposition, std::vector< std::unique_ptr< GridLevel > > &gridLevels );
     void setupMacroGrid ();
     void setupBoundaryIndices ();
 
+    template< class Ordering >
+    const OrderedGridViews< Ordering > &orderedGridViews () const;
+    void updateOrderedGridViews ();
+
     static Communication defaultCommunication ();
 
     Domain domain_;
     Mesh globalMesh_;
     MultiIndex overlap_;
+    Decomposition decomposition_;
     ReferenceCubeContainer refCubes_;
     std::vector< std::unique_ptr< GridLevel > > gridLevels_;
+    int minLevel_;
+    std::vector< std::pair< Refinement, Mesh > > discardedLevels_;
     std::vector< LevelGridView > levelGridViews_;
     LeafGridView leafGridView_;
+    mutable std::mutex orderedGridViewsMutex_;
+    mutable std::map< std::type_index, std::unique_ptr< OrderedGridViewsBase > > orderedGridViews_;
     HierarchicIndexSet hierarchicIndexSet_;
     GlobalIdSet globalIdSet_;
     LocalIdSet localIdSet_;
     Communication comm_;
+    PartitionList macroPartitions_;
     std::size_t boundarySize_;
     std::vector< std::array< std::size_t, 2*dimension > > boundaryOffset_;
     std::array< std::unique_ptr< const typename Codim< 1 >::LocalGeometryImpl >, ReferenceCube::numFaces > localFaceGeometry_;
@@ -499,16 +639,51 @@ namespace Dune
 
 
 
+  // SPGrid::OrderedGridViews
+  // ------------------------
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  template< class Ordering >
+  struct SPGrid< ct, dim, Ref, Comm, Index >::OrderedGridViews
+    : public OrderedGridViewsBase
+  {
+    typedef Dune::GridView< SPGridViewTraits< const This, Ordering > > GridView;
+    typedef typename SPGridViewTraits< const This, Ordering >::GridViewImp GridViewImp;
+
+    explicit OrderedGridViews ( const This &grid ) : leafGridView( GridViewImp() ) { update( grid ); }
+
+    void update ( const This &grid ) override
+    {
+      // note: each grid view owns its index set, so do not copy them
+      while( int( levelGridViews.size() ) > grid.maxLevel()+1 )
+        levelGridViews.pop_back();
+      while( int( levelGridViews.size() ) <= grid.maxLevel() )
+        levelGridViews.push_back( GridViewImp() );
+
+      for( int level = 0; level < grid.minLevel(); ++level )
+        levelGridViews[ level ] = GridViewImp();
+      for( int level = grid.minLevel(); level <= grid.maxLevel(); ++level )
+        levelGridViews[ level ].impl().update( grid.gridLevel( level ) );
+      leafGridView.impl().update( grid.leafLevel() );
+    }
+
+    std::vector< GridView > levelGridViews;
+    GridView leafGridView;
+  };
+
+
+
   // Implementation of SPGrid
   // ------------------------
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline SPGrid< ct, dim, Ref, Comm, Index >
     ::SPGrid ( const Domain &domain, const MultiIndex &cells,
                const Communication &comm )
   : domain_( domain ),
     globalMesh_( cells ),
     overlap_( MultiIndex::zero() ),
+    decomposition_( globalMesh_, comm.size() ),
     leafGridView_( LeafGridViewImpl() ),
     hierarchicIndexSet_( *this ),
     comm_( comm )
@@ -518,13 +693,14 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline SPGrid< ct, dim, Ref, Comm, Index >
     ::SPGrid ( const Domain &domain, const MultiIndex &cells, const MultiIndex &overlap,
                const Communication &comm )
   : domain_( domain ),
     globalMesh_( cells ),
     overlap_( overlap ),
+    decomposition_( globalMesh_, comm.size() ),
     leafGridView_( LeafGridViewImpl() ),
     hierarchicIndexSet_( *this ),
     comm_( comm )
@@ -534,13 +710,14 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline SPGrid< ct, dim, Ref, Comm, Index >
     ::SPGrid ( const GlobalVector &a, const GlobalVector &b, const MultiIndex &cells,
                const Communication &comm )
   : domain_( a, b ),
     globalMesh_( cells ),
     overlap_( MultiIndex::zero() ),
+    decomposition_( globalMesh_, comm.size() ),
     leafGridView_( LeafGridViewImpl() ),
     hierarchicIndexSet_( *this ),
     comm_( comm )
@@ -550,13 +727,31 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline SPGrid< ct, dim, Ref, Comm, Index >
     ::SPGrid ( const GlobalVector &a, const GlobalVector &b, const MultiIndex &cells,
                const MultiIndex &overlap, const Communication &comm )
   : domain_( a, b ),
     globalMesh_( cells ),
     overlap_( overlap ),
+    decomposition_( globalMesh_, comm.size() ),
+    leafGridView_( LeafGridViewImpl() ),
+    hierarchicIndexSet_( *this ),
+    comm_( comm )
+  {
+    createLocalGeometries();
+    setupMacroGrid();
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline SPGrid< ct, dim, Ref, Comm, Index >
+    ::SPGrid ( const Domain &domain, const Decomposition &decomposition, const MultiIndex &overlap,
+               const Communication &comm )
+  : domain_( domain ),
+    globalMesh_( decomposition.mesh() ),
+    overlap_( overlap ),
+    decomposition_( decomposition ),
     leafGridView_( LeafGridViewImpl() ),
     hierarchicIndexSet_( *this ),
     comm_( comm )
@@ -566,11 +761,29 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline SPGrid< ct, dim, Ref, Comm >::SPGrid ( This &&other )
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline SPGrid< ct, dim, Ref, Comm, Index >
+    ::SPGrid ( const GlobalVector &a, const GlobalVector &b, const Decomposition &decomposition,
+               const MultiIndex &overlap, const Communication &comm )
+  : domain_( a, b ),
+    globalMesh_( decomposition.mesh() ),
+    overlap_( overlap ),
+    decomposition_( decomposition ),
+    leafGridView_( LeafGridViewImpl() ),
+    hierarchicIndexSet_( *this ),
+    comm_( comm )
+  {
+    createLocalGeometries();
+    setupMacroGrid();
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline SPGrid< ct, dim, Ref, Comm, Index >::SPGrid ( This &&other )
   : domain_( std::move( other.domain_ ) ),
     globalMesh_( std::move( other.globalMesh_ ) ),
     overlap_( std::move( other.overlap_ ) ),
+    decomposition_( std::move( other.decomposition_ ) ),
     leafGridView_( LeafGridViewImpl() ),
     hierarchicIndexSet_( *this ),
     comm_( std::move( other.comm_ ) )
@@ -580,52 +793,52 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline bool SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline bool SPGrid< ct, dim, Ref, Comm, Index >
     ::mark ( const int refCount, const typename Codim< 0 >::Entity &e )
   {
     return false;
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline int SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline int SPGrid< ct, dim, Ref, Comm, Index >
     ::getMark ( const typename Codim< 0 >::Entity &e ) const
   {
     return 0;
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline bool SPGrid< ct, dim, Ref, Comm >::preAdapt ()
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline bool SPGrid< ct, dim, Ref, Comm, Index >::preAdapt ()
   {
     return false;
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline bool SPGrid< ct, dim, Ref, Comm >::adapt ()
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline bool SPGrid< ct, dim, Ref, Comm, Index >::adapt ()
   {
     return false;
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
   template< class DataHandle >
-  inline bool SPGrid< ct, dim, Ref, Comm >
+  inline bool SPGrid< ct, dim, Ref, Comm, Index >
     ::adapt ( AdaptDataHandleInterface< This, DataHandle > &handle )
   {
     return false;
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline void SPGrid< ct, dim, Ref, Comm >::postAdapt ()
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >::postAdapt ()
   {}
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline void SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >
     ::globalRefine ( const int refCount, const RefinementPolicy &policy )
   {
     for( int i = 0; i < refCount; ++i )
@@ -633,14 +846,20 @@ namespace Dune
       gridLevels_.emplace_back( new GridLevel( leafLevel(), policy ) );
       levelGridViews_.push_back( LevelGridViewImpl( leafLevel() ) );
     }
+    for( int i = 0; (i > refCount) && (maxLevel() > minLevel()); --i )
+    {
+      levelGridViews_.pop_back();
+      gridLevels_.pop_back();
+    }
     leafGridView_.impl().update( leafLevel() );
     hierarchicIndexSet_.update();
+    updateOrderedGridViews();
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
   template< class DataHandle >
-  inline void SPGrid< ct, dim, Ref, Comm >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >
     ::globalRefine ( const int refCount,
                      AdaptDataHandleInterface< This, DataHandle > &handle,
                      const RefinementPolicy &policy )
@@ -653,6 +872,7 @@ namespace Dune
       levelGridViews_.push_back( LevelGridViewImpl( leafLevel() ) );
 
       hierarchicIndexSet_.update();
+      updateOrderedGridViews();
       leafGridView_.impl().update( leafLevel() );
 
       handle.preAdapt( leafLevel().size() );
@@ -662,54 +882,132 @@ namespace Dune
         handle.postRefinement( *it );
       handle.postAdapt();
     }
+
+    for( int i = 0; (i > refCount) && (maxLevel() > minLevel()); --i )
+    {
+      const LevelGridView fatherView = levelGridView( maxLevel()-1 );
+
+      handle.preAdapt( 0 );
+      typedef typename Codim< 0 >::LevelIterator LevelIterator;
+      const LevelIterator end = fatherView.template end< 0 >();
+      for( LevelIterator it = fatherView.template begin< 0 >(); it != end; ++it )
+        handle.preCoarsening( *it );
+
+      levelGridViews_.pop_back();
+      gridLevels_.pop_back();
+
+      hierarchicIndexSet_.update();
+      updateOrderedGridViews();
+      leafGridView_.impl().update( leafLevel() );
+      handle.postAdapt();
+    }
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >::discardCoarseLevels ( int level )
+  {
+    if( level > maxLevel() )
+      DUNE_THROW( GridError, "Cannot discard levels below " << level << ", the finest level is " << maxLevel() << "." );
+    if( level <= minLevel() )
+      return;
+
+    gridLevels_[ level ]->detach();
+    for( ; minLevel_ < level; ++minLevel_ )
+    {
+      const GridLevel &gridLevel = *gridLevels_[ minLevel_ ];
+      discardedLevels_.emplace_back( gridLevel.refinement(), gridLevel.globalMesh() );
+      levelGridViews_[ minLevel_ ] = LevelGridViewImpl();
+      gridLevels_[ minLevel_ ].reset();
+    }
+    hierarchicIndexSet_.update();
+    updateOrderedGridViews();
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  template< class DataHandle, class Data >
+  inline bool SPGrid< ct, dim, Ref, Comm, Index >
+    ::loadBalance ( const Decomposition &decomposition, CommDataHandleIF< DataHandle, Data > &dataHandle )
+  {
+    checkDecomposition( decomposition );
+    if( decomposition == decomposition_ )
+      return false;
+
+    std::vector< std::unique_ptr< GridLevel > > gridLevels = makeGridLevels( decomposition );
+
+    // gather and send data on the old grid levels
+    typedef SPMigration< This, CommDataHandleIF< DataHandle, Data > > Migration;
+    std::vector< std::unique_ptr< Migration > > migrations;
+    for( std::size_t level = minLevel(); level < gridLevels.size(); ++level )
+      migrations.emplace_back( new Migration( *gridLevels_[ level ], *gridLevels[ level ], dataHandle ) );
+
+    setupGridLevels( decomposition, gridLevels );
+    __SPGrid::resizeDataHandle( static_cast< DataHandle & >( dataHandle ) );
+
+    // receive and scatter data on the new grid levels
+    for( const auto &migration : migrations )
+      migration->wait();
+    return true;
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline bool SPGrid< ct, dim, Ref, Comm, Index >::loadBalance ( const Decomposition &decomposition )
+  {
+    checkDecomposition( decomposition );
+    if( decomposition == decomposition_ )
+      return false;
+
+    std::vector< std::unique_ptr< GridLevel > > gridLevels = makeGridLevels( decomposition );
+    setupGridLevels( decomposition, gridLevels );
+    return true;
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline const typename SPGrid< ct, dim, Ref, Comm >::Communication &
-  SPGrid< ct, dim, Ref, Comm >::comm () const
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline const typename SPGrid< ct, dim, Ref, Comm, Index >::Communication &
+  SPGrid< ct, dim, Ref, Comm, Index >::comm () const
   {
     return comm_;
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline const typename SPGrid< ct, dim, Ref, Comm >::GridLevel &
-  SPGrid< ct, dim, Ref, Comm >::gridLevel ( const int level ) const
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline const typename SPGrid< ct, dim, Ref, Comm, Index >::GridLevel &
+  SPGrid< ct, dim, Ref, Comm, Index >::gridLevel ( const int level ) const
   {
-    assert( (level >= 0) && (level < int( gridLevels_.size() )) );
+    assert( (level >= minLevel()) && (level < int( gridLevels_.size() )) );
     return *gridLevels_[ level ];
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline const typename SPGrid< ct, dim, Ref, Comm >::GridLevel &
-  SPGrid< ct, dim, Ref, Comm >::leafLevel () const
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline const typename SPGrid< ct, dim, Ref, Comm, Index >::GridLevel &
+  SPGrid< ct, dim, Ref, Comm, Index >::leafLevel () const
   {
     assert( !gridLevels_.empty() );
     return *gridLevels_.back();
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline std::size_t SPGrid< ct, dim, Ref, Comm >::numBoundarySegments () const
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline std::size_t SPGrid< ct, dim, Ref, Comm, Index >::numBoundarySegments () const
   {
     return boundarySize_;
   }
 
 
   // note: this method ignores the last bit of the macroId
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline std::size_t SPGrid< ct, dim, Ref, Comm >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline std::size_t SPGrid< ct, dim, Ref, Comm, Index >
     ::boundaryIndex ( const MultiIndex &macroId,
                       const unsigned int partitionNumber,
                       const int face ) const
   {
     assert( (face >= 0) && (face < 2*dimension) );
 
-    const LevelGridView &macroView = levelGridView( 0 );
-    const GridLevel &gridLevel = macroView.impl().gridLevel();
-    const PartitionList &partitions = gridLevel.template partition< OverlapFront_Partition >();
+    const PartitionList &partitions = macroPartitions_;
     const typename PartitionList::Partition &partition = partitions.partition( partitionNumber );
 
     std::size_t index = 0;
@@ -730,8 +1028,26 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline void SPGrid< ct, dim, Ref, Comm >::createLocalGeometries ()
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline const typename SPGrid< ct, dim, Ref, Comm, Index >::Refinement &
+  SPGrid< ct, dim, Ref, Comm, Index >::refinement ( int level ) const
+  {
+    assert( (level >= 0) && (level <= maxLevel()) );
+    return (level < minLevel() ? discardedLevels_[ level ].first : gridLevel( level ).refinement());
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline const typename SPGrid< ct, dim, Ref, Comm, Index >::Mesh &
+  SPGrid< ct, dim, Ref, Comm, Index >::globalMesh ( int level ) const
+  {
+    assert( (level >= 0) && (level <= maxLevel()) );
+    return (level < minLevel() ? discardedLevels_[ level ].second : gridLevel( level ).globalMesh());
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >::createLocalGeometries ()
   {
     typedef typename Codim< 1 >::LocalGeometryImpl LocalGeometryImpl;
 
@@ -752,13 +1068,83 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline void SPGrid< ct, dim, Ref, Comm >::setupMacroGrid ()
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >
+    ::checkDecomposition ( const Decomposition &decomposition ) const
+  {
+    if( decomposition.size() != static_cast< unsigned int >( comm().size() ) )
+      DUNE_THROW( GridError, "Decomposition into " << decomposition.size() << " sub-meshes cannot be used with " << comm().size() << " ranks." );
+    if( (decomposition.mesh().begin() != globalMesh_.begin()) || (decomposition.mesh().end() != globalMesh_.end()) )
+      DUNE_THROW( GridError, "Decomposition of " << decomposition.mesh() << " does not match macro mesh " << globalMesh_ << "." );
+    if( globalMesh_.begin() != MultiIndex::zero() )
+      DUNE_THROW( GridError, "Decomposed macro mesh must start at the origin, got " << globalMesh_ << "." );
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline std::vector< std::unique_ptr< typename SPGrid< ct, dim, Ref, Comm, Index >::GridLevel > >
+  SPGrid< ct, dim, Ref, Comm, Index >::makeGridLevels ( const Decomposition &decomposition ) const
+  {
+    std::vector< std::unique_ptr< GridLevel > > gridLevels;
+    gridLevels.reserve( gridLevels_.size() );
+    gridLevels.emplace_back( new GridLevel( *this, decomposition ) );
+    for( int level = 1; level <= maxLevel(); ++level )
+      gridLevels.emplace_back( new GridLevel( *gridLevels.back(), refinement( level ).policy() ) );
+    return gridLevels;
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >
+    ::setupGridLevels ( const Decomposition &decomposition, std::vector< std::unique_ptr< GridLevel > > &gridLevels )
+  {
+    assert( gridLevels.size() == gridLevels_.size() );
+    decomposition_ = decomposition;
+    gridLevels_.swap( gridLevels );
+    setupBoundaryIndices();
+
+    // the discarded levels were only rebuilt to construct the finer ones
+    gridLevels_[ minLevel() ]->detach();
+    for( int level = 0; level < minLevel(); ++level )
+      gridLevels_[ level ].reset();
+
+    for( int level = minLevel(); level <= maxLevel(); ++level )
+      levelGridViews_[ level ].impl().update( *gridLevels_[ level ] );
+    leafGridView_.impl().update( leafLevel() );
+    hierarchicIndexSet_.update();
+    updateOrderedGridViews();
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  template< class Ordering >
+  inline const typename SPGrid< ct, dim, Ref, Comm, Index >::template OrderedGridViews< Ordering > &
+  SPGrid< ct, dim, Ref, Comm, Index >::orderedGridViews () const
+  {
+    std::lock_guard< std::mutex > guard( orderedGridViewsMutex_ );
+    std::unique_ptr< OrderedGridViewsBase > &views = orderedGridViews_[ std::type_index( typeid( Ordering ) ) ];
+    if( !views )
+      views.reset( new OrderedGridViews< Ordering >( *this ) );
+    return static_cast< const OrderedGridViews< Ordering > & >( *views );
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >::updateOrderedGridViews ()
+  {
+    for( const auto &views : orderedGridViews_ )
+      views.second->update( *this );
+  }
+
+
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >::setupMacroGrid ()
   {
-    SPDecomposition< dimension > decomposition( globalMesh_, comm().size() );
+    checkDecomposition( decomposition_ );
 
-    GridLevel *leafLevel = new GridLevel( *this, decomposition );
+    GridLevel *leafLevel = new GridLevel( *this, decomposition_ );
     gridLevels_.emplace_back( leafLevel );
+    minLevel_ = 0;
     levelGridViews_.push_back( LevelGridViewImpl( *leafLevel ) );
     leafGridView_.impl().update( *leafLevel );
     hierarchicIndexSet_.update();
@@ -766,12 +1152,12 @@ namespace Dune
   }
 
 
-  template< class ct, int dim, template< int > class Ref, class Comm >
-  inline void SPGrid< ct, dim, Ref, Comm >::setupBoundaryIndices ()
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index >
+  inline void SPGrid< ct, dim, Ref, Comm, Index >::setupBoundaryIndices ()
   {
-    const LevelGridView &macroView = levelGridView( 0 );
-    const GridLevel &gridLevel = macroView.impl().gridLevel();
-    const PartitionList &partitions = gridLevel.template partition< OverlapFront_Partition >();
+    // note: keep the macro partitions, the macro level might be discarded
+    macroPartitions_ = gridLevels_.front()->template partition< OverlapFront_Partition >();
+    const PartitionList &partitions = macroPartitions_;
 
     boundarySize_ = 0;
     boundaryOffset_.resize( partitions.maxNumber() - partitions.minNumber() + 1 );
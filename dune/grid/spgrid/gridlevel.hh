@@ -2,9 +2,12 @@
 #define DUNE_SPGRID_GRIDLEVEL_HH
 
 #include <cassert>
+#include <limits>
 #include <vector>
 #include <type_traits>
 
+#include <dune/grid/common/exceptions.hh>
+
 #include <dune/grid/spgrid/direction.hh>
 #include <dune/grid/spgrid/geometricgridlevel.hh>
 #include <dune/grid/spgrid/misc.hh>
@@ -51,6 +54,7 @@ namespace Dune
     typedef typename Traits::Domain Domain;
     typedef typename Traits::Refinement Refinement;
     typedef typename Traits::RefinementPolicy RefinementPolicy;
+    typedef typename Traits::LocalIdType IdType;
 
     typedef typename ReferenceCube::GlobalVector GlobalVector;
     typedef typename ReferenceCube::MultiIndex MultiIndex;
@@ -87,6 +91,14 @@ namespace Dune
     const Mesh &globalMesh () const;
     const Mesh &localMesh () const;
 
+    /** \brief decomposition of the macro mesh (shared by all levels) */
+    const Decomposition &decomposition () const { return decomposition_; }
+
+    /** \brief sub-mesh assigned to a rank on this level */
+    Mesh subMesh ( int rank ) const;
+
+    const PartitionPool &partitionPool () const { return partitionPool_; }
+
     template< PartitionIteratorType pitype >
     const PartitionList &partition () const;
 
@@ -100,13 +112,26 @@ namespace Dune
 
     MultiIndex macroId ( const MultiIndex &id ) const;
 
+    /** \brief number of cells per macro cell along each axis */
+    const MultiIndex &macroFactor () const { return macroFactor_; }
+
     size_t boundaryIndex ( const MultiIndex &id,
                            const unsigned int partitionNumber,
                            const int face ) const;
 
     LocalGeometry geometryInFather ( const MultiIndex &id ) const;
 
-    int size () const;
+    long size () const;
+
+    /** \brief first local id of the entities on a level (up to this one, see SPLocalIdSet) */
+    IdType idOffset ( int level ) const
+    {
+      assert( (level >= 0) && (level <= level_) );
+      return idOffsets_[ level ];
+    }
+
+    /** \brief release all references to the father level */
+    void detach () { linkage_.detach(); }
 
   private:
     void buildLocalGeometry ();
@@ -115,6 +140,7 @@ namespace Dune
     static MultiIndex coarseMacroFactor ();
     static GlobalVector meshWidth ( const Domain &domain, const Mesh &mesh );
     static MultiIndex refineWidth ( const MultiIndex &width, const Refinement &refinement );
+    static std::vector< IdType > extendIdOffsets ( std::vector< IdType > idOffsets, const Mesh &globalMesh );
 
     MultiIndex overlap () const;
 
@@ -124,7 +150,7 @@ namespace Dune
     const Refinement refinement_;
     MultiIndex macroFactor_;
     Domain domain_;
-    std::vector< Mesh > decomposition_;
+    Decomposition decomposition_;
     Mesh localMesh_;
     PartitionPool partitionPool_;
     Linkage linkage_;
@@ -132,6 +158,8 @@ namespace Dune
     LocalGeometryImpl **geometryInFather_;
 
     PartitionList boundaryPartition_[ numFaces+1 ];
+
+    std::vector< IdType > idOffsets_;
   };
 
 
@@ -148,10 +176,11 @@ namespace Dune
     refinement_(),
     macroFactor_( coarseMacroFactor() ),
     domain_( grid.domain() ),
-    decomposition_( decomposition.subMeshes() ),
-    localMesh_( decomposition_[ grid.comm().rank() ] ),
+    decomposition_( decomposition ),
+    localMesh_( decomposition_.subMesh( grid.comm().rank() ) ),
     partitionPool_( localMesh_, decomposition.mesh(), overlap(), domain_.topology() ),
-    linkage_( grid.comm().rank(), partitionPool_, decomposition_ )
+    linkage_( grid.comm().rank(), partitionPool_, decomposition_, macroFactor_ ),
+    idOffsets_( extendIdOffsets( std::vector< IdType >( 1, 0 ), globalMesh() ) )
   {
     buildLocalGeometry();
     buildBoundaryPartitions();
@@ -166,10 +195,11 @@ namespace Dune
       refinement_( father.refinement(), policy ),
       macroFactor_( refineWidth( father.macroFactor_, refinement_ ) ),
       domain_( father.domain() ),
-      decomposition_( transform( father.decomposition_, [ this ]( const Mesh &mesh ) { return mesh.refine( refinement_ ); } ) ),
+      decomposition_( father.decomposition_ ),
       localMesh_( father.localMesh().refine( refinement_ ) ),
       partitionPool_( localMesh_, father.globalMesh().refine( refinement_ ), overlap(), domain_.topology() ),
-      linkage_( father.grid().comm().rank(), partitionPool_, decomposition_ )
+      linkage_( father.grid().comm().rank(), partitionPool_, father.linkage_, refinement_ ),
+      idOffsets_( extendIdOffsets( father.idOffsets_, globalMesh() ) )
   {
     buildLocalGeometry();
     buildBoundaryPartitions();
@@ -186,7 +216,8 @@ namespace Dune
     decomposition_( other.decomposition_ ),
     localMesh_( other.localMesh_ ),
     partitionPool_( other.partitionPool_ ),
-    linkage_( other.linkage_ )
+    linkage_( other.linkage_, partitionPool_ ),
+    idOffsets_( other.idOffsets_ )
   {
     buildLocalGeometry();
     buildBoundaryPartitions();
@@ -221,6 +252,21 @@ namespace Dune
   }
 
 
+  template< class Grid >
+  inline typename SPGridLevel< Grid >::Mesh
+  SPGridLevel< Grid >::subMesh ( int rank ) const
+  {
+    const Mesh &macroMesh = decomposition_.subMesh( rank );
+    MultiIndex begin, end;
+    for( int i = 0; i < dimension; ++i )
+    {
+      begin[ i ] = macroFactor_[ i ] * macroMesh.begin()[ i ];
+      end[ i ] = macroFactor_[ i ] * macroMesh.end()[ i ];
+    }
+    return Mesh( begin, end );
+  }
+
+
   template< class Grid >
   template< PartitionIteratorType pitype >
   inline const typename SPGridLevel< Grid >::PartitionList &
@@ -292,7 +338,27 @@ namespace Dune
 
 
   template< class Grid >
-  inline int SPGridLevel< Grid >::size () const
+  inline std::vector< typename SPGridLevel< Grid >::IdType >
+  SPGridLevel< Grid >::extendIdOffsets ( std::vector< IdType > idOffsets, const Mesh &globalMesh )
+  {
+    // each level reserves one id per multi-index in its global mesh
+    IdType count = 1;
+    for( int i = 0; i < dimension; ++i )
+    {
+      const IdType w = IdType( 2*globalMesh.width( i ) + 1 );
+      if( count > std::numeric_limits< IdType >::max() / w )
+        DUNE_THROW( GridError, "Local ids of level " << (idOffsets.size()-1) << " exceed the id type." );
+      count *= w;
+    }
+    if( idOffsets.back() > std::numeric_limits< IdType >::max() - count )
+      DUNE_THROW( GridError, "Local ids of level " << (idOffsets.size()-1) << " exceed the id type." );
+    idOffsets.push_back( idOffsets.back() + count );
+    return idOffsets;
+  }
+
+
+  template< class Grid >
+  inline long SPGridLevel< Grid >::size () const
   {
     return globalMesh().volume();
   }
@@ -1,6 +1,7 @@
 #ifndef DUNE_SPGRID_GRIDVIEW_HH
 #define DUNE_SPGRID_GRIDVIEW_HH
 
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 
@@ -31,14 +32,20 @@ namespace Dune
   // SPGridViewTraits
   // ----------------
 
-  template< class G >
+  /**
+   * \brief traits of SPGridView
+   *
+   * \tparam  G         grid type
+   * \tparam  Ordering  ordering of the index set (e.g., SPMortonOrdering)
+   */
+  template< class G, class Ordering = SPLexicographicOrdering >
   struct SPGridViewTraits
   {
-    typedef SPGridView< SPGridViewTraits< G > > GridViewImp;
+    typedef SPGridView< SPGridViewTraits< G, Ordering > > GridViewImp;
 
     typedef typename std::remove_const< G >::type Grid;
 
-    typedef SPIndexSet< const Grid > IndexSet;
+    typedef SPIndexSet< const Grid, Ordering > IndexSet;
     typedef Dune::Intersection< const Grid, SPIntersection< const Grid > > Intersection;
     typedef Dune::IntersectionIterator< const Grid, SPIntersectionIterator< const Grid >, SPIntersection< const Grid > > IntersectionIterator;
 
@@ -48,6 +55,8 @@ namespace Dune
     typedef typename Grid::Communication Communication;
     typedef Communication CollectiveCommunication;
 
+    typedef SPTraversal< Grid::dimension > Traversal;
+
     static const bool conforming = true;
 
     template< int codim >
@@ -83,19 +92,23 @@ namespace Dune
   {
     typedef SPGridView< ViewTraits > This;
 
-    template< class, int, template< int > class, class > friend class SPGrid;
+    template< class, int, template< int > class, class, class > friend class SPGrid;
     template< class > friend class SPGridView;
 
   public:
     typedef typename ViewTraits::Grid Grid;
     typedef typename ViewTraits::IndexSet IndexSet;
+    typedef typename IndexSet::IndexType IndexType;
     typedef typename ViewTraits::IntersectionIterator IntersectionIterator;
     typedef typename ViewTraits::BoundarySegmentIterator BoundarySegmentIterator;
     typedef typename ViewTraits::Communication Communication;
     typedef Communication CollectiveCommunication;
+    typedef typename ViewTraits::Traversal Traversal;
 
     typedef SPGridLevel< Grid > GridLevel;
 
+    typedef SPPartitionList< Grid::dimension > PartitionList;
+
     template< int codim >
     struct Codim
       : public ViewTraits::template Codim< codim >
@@ -117,27 +130,48 @@ namespace Dune
 
     bool isConforming() const { return bool(ViewTraits::conforming); }
 
-    int size ( int codim ) const;
-    int size ( const GeometryType &type ) const;
+    IndexType size ( int codim ) const;
+    IndexType size ( const GeometryType &type ) const;
 
     int overlapSize ( const int codim ) const;
     int ghostSize ( const int codim ) const;
 
     template< int codim >
     typename Codim< codim >::Iterator
-    begin ( const unsigned int sweepDir = 0 ) const;
+    begin ( const Traversal &traversal = Traversal() ) const;
 
     template< int codim >
     typename Codim< codim >::Iterator
-    end ( const unsigned int sweepDir = 0 ) const;
+    end ( const Traversal &traversal = Traversal() ) const;
 
     template< int codim, PartitionIteratorType pitype >
     typename Codim< codim >::template Partition< pitype >::Iterator
-    begin ( const unsigned int sweepDir = 0 ) const;
+    begin ( const Traversal &traversal = Traversal() ) const;
 
     template< int codim, PartitionIteratorType pitype >
     typename Codim< codim >::template Partition< pitype >::Iterator
-    end ( const unsigned int sweepDir = 0 ) const;
+    end ( const Traversal &traversal = Traversal() ) const;
+
+    /** \brief iterate over a partition list, e.g., deepInterior( width ) (which must outlive the iterator) */
+    template< int codim >
+    typename Codim< codim >::template Partition< Interior_Partition >::Iterator
+    begin ( const PartitionList &partitionList, const Traversal &traversal = Traversal() ) const;
+
+    template< int codim >
+    typename Codim< codim >::template Partition< Interior_Partition >::Iterator
+    end ( const PartitionList &partitionList, const Traversal &traversal = Traversal() ) const;
+
+    /**
+     * \brief interior entities whose stencil of given width (in cells) does
+     *        not touch border or overlap entities
+     *
+     * The deep interior can be processed while a communication is in
+     * progress, the shell after it has finished.
+     */
+    PartitionList deepInterior ( int width ) const { return gridLevel().partitionPool().deepInterior( uniform( width ) ); }
+
+    /** \brief interior entities outside the deep interior */
+    PartitionList shell ( int width ) const { return gridLevel().partitionPool().shell( uniform( width ) ); }
 
     IntersectionIterator ibegin ( const typename Codim< 0 >::Entity &entity ) const;
     IntersectionIterator iend ( const typename Codim< 0 >::Entity &entity ) const;
@@ -167,6 +201,13 @@ namespace Dune
     void update ( const GridLevel &gridLevel ) { assert( indexSet_ ); indexSet_->update( gridLevel ); }
 
   private:
+    static typename GridLevel::MultiIndex uniform ( int width )
+    {
+      typename GridLevel::MultiIndex multiIndex;
+      std::fill( multiIndex.begin(), multiIndex.end(), width );
+      return multiIndex;
+    }
+
     std::shared_ptr< IndexSet > indexSet_;
   };
 
@@ -192,14 +233,14 @@ namespace Dune
 
 
   template< class ViewTraits >
-  inline int SPGridView< ViewTraits >::size ( int codim ) const
+  inline typename SPGridView< ViewTraits >::IndexType SPGridView< ViewTraits >::size ( int codim ) const
   {
     return indexSet().size( codim );
   }
 
 
   template< class ViewTraits >
-  inline int SPGridView< ViewTraits >::size ( const GeometryType &type ) const
+  inline typename SPGridView< ViewTraits >::IndexType SPGridView< ViewTraits >::size ( const GeometryType &type ) const
   {
     return indexSet().size( type );
   }
@@ -210,7 +251,7 @@ namespace Dune
   {
     if( codim != 0 )
       DUNE_THROW( NotImplemented, "overlapSize not implemented for codim > 0." );
-    int volume = gridLevel().template partition< OverlapFront_Partition >().volume();
+    long volume = gridLevel().template partition< OverlapFront_Partition >().volume();
     volume -= gridLevel().template partition< InteriorBorder_Partition >().volume();
     return volume;
   }
@@ -228,44 +269,66 @@ namespace Dune
   template< class ViewTraits >
   template< int codim >
   inline typename SPGridView< ViewTraits >::template Codim< codim >::Iterator
-  SPGridView< ViewTraits >::begin ( const unsigned int sweepDir ) const
+  SPGridView< ViewTraits >::begin ( const Traversal &traversal ) const
   {
     typedef typename Codim< codim >::IteratorImpl IteratorImpl;
     typename IteratorImpl::Begin begin;
-    return IteratorImpl( gridLevel(), gridLevel().template partition< All_Partition >(), begin, sweepDir );
+    return IteratorImpl( gridLevel(), gridLevel().template partition< All_Partition >(), begin, traversal );
   }
 
 
   template< class ViewTraits >
   template< int codim >
   inline typename SPGridView< ViewTraits >::template Codim< codim >::Iterator
-  SPGridView< ViewTraits >::end ( const unsigned int sweepDir ) const
+  SPGridView< ViewTraits >::end ( const Traversal &traversal ) const
   {
     typedef typename Codim< codim >::IteratorImpl IteratorImpl;
     typename IteratorImpl::End end;
-    return IteratorImpl( gridLevel(), gridLevel().template partition< All_Partition >(), end, sweepDir );
+    return IteratorImpl( gridLevel(), gridLevel().template partition< All_Partition >(), end, traversal );
   }
 
 
   template< class ViewTraits >
   template< int codim, PartitionIteratorType pitype >
   inline typename SPGridView< ViewTraits >::template Codim< codim >::template Partition< pitype >::Iterator
-  SPGridView< ViewTraits >::begin ( const unsigned int sweepDir ) const
+  SPGridView< ViewTraits >::begin ( const Traversal &traversal ) const
   {
     typedef typename Codim< codim >::template Partition< pitype >::IteratorImpl IteratorImpl;
     typename IteratorImpl::Begin begin;
-    return IteratorImpl( gridLevel(), gridLevel().template partition< pitype >(), begin, sweepDir );
+    return IteratorImpl( gridLevel(), gridLevel().template partition< pitype >(), begin, traversal );
   }
 
 
   template< class ViewTraits >
   template< int codim, PartitionIteratorType pitype >
   inline typename SPGridView< ViewTraits >::template Codim< codim >::template Partition< pitype >::Iterator
-  SPGridView< ViewTraits >::end ( const unsigned int sweepDir ) const
+  SPGridView< ViewTraits >::end ( const Traversal &traversal ) const
   {
     typedef typename Codim< codim >::template Partition< pitype >::IteratorImpl IteratorImpl;
     typename IteratorImpl::End end;
-    return IteratorImpl( gridLevel(), gridLevel().template partition< pitype >(), end, sweepDir );
+    return IteratorImpl( gridLevel(), gridLevel().template partition< pitype >(), end, traversal );
+  }
+
+
+  template< class ViewTraits >
+  template< int codim >
+  inline typename SPGridView< ViewTraits >::template Codim< codim >::template Partition< Interior_Partition >::Iterator
+  SPGridView< ViewTraits >::begin ( const PartitionList &partitionList, const Traversal &traversal ) const
+  {
+    typedef typename Codim< codim >::template Partition< Interior_Partition >::IteratorImpl IteratorImpl;
+    typename IteratorImpl::Begin begin;
+    return IteratorImpl( gridLevel(), partitionList, begin, traversal );
+  }
+
+
+  template< class ViewTraits >
+  template< int codim >
+  inline typename SPGridView< ViewTraits >::template Codim< codim >::template Partition< Interior_Partition >::Iterator
+  SPGridView< ViewTraits >::end ( const PartitionList &partitionList, const Traversal &traversal ) const
+  {
+    typedef typename Codim< codim >::template Partition< Interior_Partition >::IteratorImpl IteratorImpl;
+    typename IteratorImpl::End end;
+    return IteratorImpl( gridLevel(), partitionList, end, traversal );
   }
 
 
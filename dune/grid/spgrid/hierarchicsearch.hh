@@ -17,9 +17,6 @@ namespace Dune
   // External Forward Declarations
   // -----------------------------
 
-  template< class Grid >
-  class SPIndexSet;
-
   template< class Grid, class IndexSet >
   class HierarchicSearch;
 
@@ -146,12 +143,12 @@ namespace Dune
   // SPHierarchicSearch for SPIndexSet
   // ---------------------------------
 
-  template< class Grid >
-  class SPHierarchicSearch< Grid, SPIndexSet< Grid > >
+  template< class Grid, class Ordering >
+  class SPHierarchicSearch< Grid, SPIndexSet< Grid, Ordering > >
   : protected SPBasicHierarchicSearch< Grid >
   {
     typedef SPBasicHierarchicSearch< Grid > Base;
-    typedef SPIndexSet< Grid > IndexSet;
+    typedef SPIndexSet< Grid, Ordering > IndexSet;
 
   public:
     typedef typename Base::Entity Entity;
@@ -177,16 +174,16 @@ namespace Dune
   // SPHierarchicSearch for IndexSet< SPIndexSet >
   // ---------------------------------------------
 
-  template< class Grid >
-  class SPHierarchicSearch< Grid, IndexSet< Grid, SPIndexSet< Grid >, typename SPIndexSet< Grid >::IndexType > >
-  : public SPHierarchicSearch< Grid, SPIndexSet< Grid > >
+  template< class Grid, class Ordering >
+  class SPHierarchicSearch< Grid, IndexSet< Grid, SPIndexSet< Grid, Ordering >, typename SPIndexSet< Grid, Ordering >::IndexType > >
+  : public SPHierarchicSearch< Grid, SPIndexSet< Grid, Ordering > >
   {
-    typedef SPHierarchicSearch< Grid, SPIndexSet< Grid > > Base;
-    typedef Dune::IndexSet< Grid, SPIndexSet< Grid >, typename SPIndexSet< Grid >::IndexType > IndexSet;
+    typedef SPHierarchicSearch< Grid, SPIndexSet< Grid, Ordering > > Base;
+    typedef Dune::IndexSet< Grid, SPIndexSet< Grid, Ordering >, typename SPIndexSet< Grid, Ordering >::IndexType > IndexSet;
 
   public:
     SPHierarchicSearch ( const Grid &grid, const IndexSet &indexSet )
-    : Base( grid, static_cast< const SPIndexSet< Grid > & >( indexSet ) )
+    : Base( grid, static_cast< const SPIndexSet< Grid, Ordering > & >( indexSet ) )
     {}
   };
 
@@ -195,12 +192,12 @@ namespace Dune
   // HierarchicSearch for SPGrid
   // ---------------------------
 
-  template< class ct, int dim, template< int > class Ref, class Comm, class IndexSet >
-  class HierarchicSearch< SPGrid< ct, dim, Ref, Comm >, IndexSet >
-    : public SPHierarchicSearch< SPGrid< ct, dim, Ref, Comm >, IndexSet >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index, class IndexSet >
+  class HierarchicSearch< SPGrid< ct, dim, Ref, Comm, Index >, IndexSet >
+    : public SPHierarchicSearch< SPGrid< ct, dim, Ref, Comm, Index >, IndexSet >
   {
-    typedef SPHierarchicSearch< SPGrid< ct, dim, Ref, Comm >, IndexSet > Base;
-    typedef SPGrid< ct, dim, Ref, Comm > Grid;
+    typedef SPHierarchicSearch< SPGrid< ct, dim, Ref, Comm, Index >, IndexSet > Base;
+    typedef SPGrid< ct, dim, Ref, Comm, Index > Grid;
 
   public:
     typedef typename Base::Entity Entity;
@@ -15,10 +15,10 @@ namespace Dune
 
   template< class Grid >
   class SPHierarchyIndexSet
-    : public IndexSet< Grid, SPHierarchyIndexSet< Grid >, unsigned int, std::array< GeometryType, 1 > >
+    : public IndexSet< Grid, SPHierarchyIndexSet< Grid >, typename std::remove_const< Grid >::type::Traits::IndexType, std::array< GeometryType, 1 > >
   {
     typedef SPHierarchyIndexSet< Grid > This;
-    typedef IndexSet< Grid, This, unsigned int, std::array< GeometryType, 1 > > Base;
+    typedef IndexSet< Grid, This, typename std::remove_const< Grid >::type::Traits::IndexType, std::array< GeometryType, 1 > > Base;
 
     typedef typename std::remove_const< Grid >::type::Traits Traits;
 
@@ -55,10 +55,11 @@ namespace Dune
       for( int codim = 0; codim <= dimension; ++codim )
         size_[ codim ] = 0;
 
+      // note: discarded coarse levels do not contribute any indices
       const int maxLevel = grid().maxLevel();
-      levelIndexSets_.resize( maxLevel+1 );
+      levelIndexSets_.assign( maxLevel+1, nullptr );
       offsets_.resize( maxLevel+1 );
-      for( int level = 0; level <= maxLevel; ++level )
+      for( int level = grid().minLevel(); level <= maxLevel; ++level )
       {
         const LevelIndexSet &levelIndexSet = grid().levelIndexSet( level );
         levelIndexSets_[ level ] = &levelIndexSet;
@@ -104,7 +105,7 @@ namespace Dune
 
     const std::vector< GeometryType > &geomTypes ( const int codim ) const
     {
-      return levelIndexSet( 0 ).geomTypes( codim );
+      return levelIndexSet( grid().maxLevel() ).geomTypes( codim );
     }
 
     IndexType size ( const GeometryType &type ) const
@@ -137,8 +138,9 @@ namespace Dune
 
     const LevelIndexSet &levelIndexSet ( const int level ) const
     {
-      assert( (level >= 0) && (level <= (int)levelIndexSets_.size()) );
+      assert( (level >= 0) && (level < (int)levelIndexSets_.size()) );
       assert( (int)levelIndexSets_.size() == grid().maxLevel()+1 );
+      assert( levelIndexSets_[ level ] );
       return *levelIndexSets_[ level ];
     }
 
@@ -14,6 +14,14 @@ namespace Dune
   // SPLocalIdSet
   // ------------
 
+  /**
+   * \brief local id set (also used as global id set)
+   *
+   * Each level reserves a contiguous block of ids, one for each multi-index
+   * in its global mesh (see SPGridLevel::idOffset). An entity gets the id of
+   * the multi-index on the coarsest level it is a copy of. Construction of
+   * the grid fails if the ids do not fit into the id type.
+   */
   template< class Grid >
   class SPLocalIdSet
     : public IdSet< Grid, SPLocalIdSet< Grid >, unsigned long >
@@ -41,8 +49,6 @@ namespace Dune
     typedef typename GridLevel::MultiIndex MultiIndex;
     typedef typename GridLevel::Mesh Mesh;
 
-    static const int levelShift = 8*sizeof( IdType ) - 8;
-
     IdType computeId ( const GridLevel &gridLevel, const MultiIndex &id ) const;
 
     template< int cd >
@@ -90,25 +96,47 @@ namespace Dune
   inline SPLocalIdSet< Grid >
     ::computeId ( const GridLevel &gridLevel, const MultiIndex &id ) const
   {
-    const unsigned int level = gridLevel.level();
-    if( (level > 0) && gridLevel.refinement().isCopy( id ) )
+    // note: copies are identified with their fathers, even if the father
+    //       level has been discarded
+    const Grid &grid = gridLevel.grid();
+    const int level = gridLevel.level();
+    const Mesh &globalMesh = gridLevel.globalMesh();
+
+    // An entity is a copy from level k iff, along each axis, it is not
+    // refined between k and this level or its position is divisible by the
+    // accumulated refinement factor. As this is monotone in k, we can search
+    // the coarsest level instead of following the fathers.
+    auto isCopy = [ &grid, &globalMesh, &id ] ( int k ) {
+        const Mesh &coarseMesh = grid.globalMesh( k );
+        bool copy = true;
+        for( int i = 0; i < dimension; ++i )
+        {
+          const int factor = globalMesh.width( i ) / coarseMesh.width( i );
+          copy &= (factor == 1) || ((id[ i ] % (2*factor)) == 0);
+        }
+        return copy;
+      };
+
+    int coarse = 0;
+    for( int fine = level; coarse < fine; )
     {
-      const Grid &grid = gridLevel.grid();
-      MultiIndex fatherId( id );
-      gridLevel.refinement().father( fatherId );
-      return computeId( grid.gridLevel( level-1 ), fatherId );
+      const int k = (coarse + fine) / 2;
+      if( isCopy( k ) )
+        fine = k;
+      else
+        coarse = k+1;
     }
 
-    const Mesh &globalMesh = gridLevel.globalMesh();
-
+    const Mesh &coarseMesh = grid.globalMesh( coarse );
     IdType index = 0;
     IdType factor = 1;
     for( int i = 0; i < dimension; ++i )
     {
-      index += IdType( id[ i ] ) * factor;
-      factor *= IdType( 2*globalMesh.width( i ) + 1 );
+      const int refine = globalMesh.width( i ) / coarseMesh.width( i );
+      index += IdType( (id[ i ] / refine) | (id[ i ] & 1) ) * factor;
+      factor *= IdType( 2*coarseMesh.width( i ) + 1 );
     }
-    return index | (IdType( level ) << levelShift);
+    return index + gridLevel.idOffset( coarse );
   }
 
 
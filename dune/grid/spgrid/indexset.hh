@@ -1,24 +1,71 @@
 #ifndef DUNE_SPGRID_INDEXSET_HH
 #define DUNE_SPGRID_INDEXSET_HH
 
+#include <algorithm>
 #include <array>
 #include <type_traits>
 #include <vector>
 
+#include <dune/grid/common/gridenums.hh>
 #include <dune/grid/common/indexidset.hh>
 
+#include <dune/grid/spgrid/declaration.hh>
+#include <dune/grid/spgrid/entity.hh>
 #include <dune/grid/spgrid/entityinfo.hh>
 #include <dune/grid/spgrid/gridlevel.hh>
+#include <dune/grid/spgrid/ordering.hh>
 
 namespace Dune
 {
 
-  template< class Grid >
+  namespace __SPGrid
+  {
+
+    // IsOwnerFirst
+    // ------------
+
+    template< class Ordering >
+    struct IsOwnerFirst
+      : public std::false_type
+    {};
+
+    template< class Ordering >
+    struct IsOwnerFirst< SPOwnerFirstOrdering< Ordering > >
+      : public std::true_type
+    {};
+
+  } // namespace __SPGrid
+
+
+
+  // SPIndexSet
+  // ----------
+
+  /**
+   * \brief index set of a grid level
+   *
+   * The entities are numbered partition by partition and direction by
+   * direction. Within each of these boxes, the entities are ordered by the
+   * Ordering, e.g., SPLexicographicOrdering (default) or SPMortonOrdering.
+   * For SPOwnerFirstOrdering, the boxes are further cut by partition type
+   * and owner rank, and the resulting blocks are numbered interior first,
+   * followed by the owned border entities and the remaining entities
+   * grouped by owner.
+   *
+   * By default, all entities are numbered. Given another partition type,
+   * e.g., Interior_Partition, only the entities of the corresponding
+   * partition list are numbered, still computing the index arithmetically.
+   * Such an index set can be constructed from the grid level of a view:
+   * \code
+   * const SPIndexSet< const Grid, SPLexicographicOrdering, Interior_Partition > interiorIndexSet( gridView.impl().gridLevel() );
+   * \endcode
+   */
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   class SPIndexSet
-    : public IndexSet< Grid, SPIndexSet< Grid >, unsigned int, std::array< GeometryType, 1 > >
+    : public IndexSet< Grid, SPIndexSet< Grid, Ordering, pitype >, typename std::remove_const< Grid >::type::Traits::IndexType, std::array< GeometryType, 1 > >
   {
-    typedef SPIndexSet< Grid > This;
-    typedef IndexSet< Grid, This, unsigned int, std::array< GeometryType, 1 > > Base;
+    typedef SPIndexSet< Grid, Ordering, pitype > This;
+    typedef IndexSet< Grid, This, typename std::remove_const< Grid >::type::Traits::IndexType, std::array< GeometryType, 1 > > Base;
 
     typedef typename std::remove_const< Grid >::type::Traits Traits;
 
@@ -37,10 +84,35 @@ namespace Dune
 
     typedef SPGridLevel< typename std::remove_const< Grid >::type > GridLevel;
     typedef typename GridLevel::PartitionList PartitionList;
+    typedef typename GridLevel::MultiIndex MultiIndex;
 
   private:
-    typedef typename GridLevel::MultiIndex MultiIndex;
     typedef typename PartitionList::Partition Partition;
+    typedef typename GridLevel::Mesh Mesh;
+
+    static const bool ownerFirst = __SPGrid::IsOwnerFirst< Ordering >::value;
+
+    // block of entities with the same partition type and owner
+    struct Block
+    {
+      IndexType offset;
+      MultiIndex begin, width;
+    };
+
+    // blocks of a partition and direction (tensor product of the intervals between the cuts)
+    struct Box
+    {
+      std::array< std::vector< int >, dimension > cuts;
+      std::vector< Block > blocks;
+    };
+
+    // consecutive range of indices starting at offset (used to invert index)
+    struct Segment
+    {
+      IndexType offset;
+      unsigned int number, dir;
+      std::size_t block;
+    };
 
   public:
     SPIndexSet () = default;
@@ -48,9 +120,18 @@ namespace Dune
 
     void update ( const GridLevel &gridLevel );
 
-  private:
+    /** \brief index of the entity with given id within a partition (see forEachIndex) */
     IndexType index ( const MultiIndex &id, unsigned int number ) const;
 
+    /** \brief id and partition number of the entity with given index (inverse of index) */
+    MultiIndex id ( int codim, IndexType index, unsigned int &number ) const;
+
+  private:
+    IndexType blockIndex ( const MultiIndex &id, unsigned int number ) const;
+
+    void updateBlocks ();
+    unsigned int owner ( const MultiIndex &id ) const;
+
     template< int cd >
     IndexType subIndex ( const MultiIndex &id, int i, int codim, unsigned int number, std::integral_constant< int, cd > ) const;
     IndexType subIndex ( const MultiIndex &id, int i, int codim, unsigned int number, std::integral_constant< int, 0 > ) const;
@@ -69,6 +150,10 @@ namespace Dune
     template< int cd >
     IndexType subIndex ( const typename Codim< cd >::Entity &entity, int i, unsigned int codim ) const;
 
+    /** \brief entity with given index (no entity seeds need to be stored) */
+    template< int codim >
+    typename Codim< codim >::Entity entity ( IndexType index ) const;
+
     Types types ( int codim ) const { return {{ GeometryTypes::cube( dimension - codim ) }}; }
 
     IndexType size ( const GeometryType &type ) const;
@@ -88,6 +173,8 @@ namespace Dune
     const GridLevel *gridLevel_ = nullptr;
     const PartitionList *partitions_ = nullptr;
     std::vector< std::array< IndexType, 1 << dimension > > offsets_;
+    std::vector< std::array< Box, 1 << dimension > > boxes_;
+    std::vector< Segment > segments_[ dimension+1 ];
     IndexType size_[ dimension+1 ];
   };
 
@@ -96,14 +183,17 @@ namespace Dune
   // Implementation of SPIndexSet
   // ----------------------------
 
-  template< class Grid >
-  void SPIndexSet< Grid >::update ( const GridLevel &gridLevel )
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  void SPIndexSet< Grid, Ordering, pitype >::update ( const GridLevel &gridLevel )
   {
     gridLevel_ = &gridLevel;
-    partitions_ = &gridLevel.template partition< All_Partition >();
+    partitions_ = &gridLevel.template partition< pitype >();
 
     for( int codim = 0; codim <= dimension; ++codim )
+    {
       size_[ codim ] = 0;
+      segments_[ codim ].clear();
+    }
 
     offsets_.resize( partitions().maxNumber() - partitions().minNumber() + 1 );
     for( typename PartitionList::Iterator pit = partitions().begin(); pit; ++pit )
@@ -121,20 +211,225 @@ namespace Dune
           codim -= d;
         }
         offsets_[ pit->number() - partitions().minNumber() ][ dir ] = size_[ codim ];
+        if( factor > 0 )
+          segments_[ codim ].push_back( { size_[ codim ], pit->number(), dir, 0 } );
         size_[ codim ] += factor;
       }
     }
+
+    if( ownerFirst )
+      updateBlocks();
   }
 
 
-  template< class Grid >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >::index ( const MultiIndex &id, unsigned int number ) const
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline void SPIndexSet< Grid, Ordering, pitype >::updateBlocks ()
   {
+    const auto &partitionPool = gridLevel().partitionPool();
+    const PartitionList &interior = partitionPool.template get< Interior_Partition >();
+    const PartitionList &interiorBorder = partitionPool.template get< InteriorBorder_Partition >();
+    const Mesh &localMesh = gridLevel().localMesh();
+    const Mesh &globalMesh = gridLevel().globalMesh();
+    const Mesh &macroMesh = gridLevel().decomposition().mesh();
+    const MultiIndex &macroFactor = gridLevel().macroFactor();
+    const unsigned int localRank = gridLevel().grid().comm().rank();
+
+    // find the ranks owning entities of this index set (including the periodic images)
+    std::vector< unsigned int > ranks;
+    for( typename PartitionList::Iterator pit = partitions().begin(); pit; ++pit )
+    {
+      MultiIndex begin, end;
+      unsigned int wrap = 0;
+      for( int i = 0; i < dimension; ++i )
+      {
+        begin[ i ] = (pit->begin()[ i ] / 2) / macroFactor[ i ];
+        end[ i ] = ((pit->end()[ i ] / 2) + macroFactor[ i ] - 1) / macroFactor[ i ];
+        if( partitionPool.topology().hasNeighbor( 0, 2*i ) && (end[ i ] >= macroMesh.end()[ i ]) )
+          wrap |= (1u << i);
+      }
+      const Mesh mesh = Mesh( begin, end ).grow( 1 ).intersect( macroMesh );
+      for( unsigned int s = 0; s < (1u << dimension); ++s )
+      {
+        if( (s & wrap) != s )
+          continue;
+        MultiIndex sbegin = mesh.begin(), send = mesh.end();
+        for( int i = 0; i < dimension; ++i )
+        {
+          if( (s >> i) & 1 )
+          {
+            sbegin[ i ] = macroMesh.begin()[ i ];
+            send[ i ] = macroMesh.begin()[ i ] + 1;
+          }
+        }
+        gridLevel().decomposition().intersect( Mesh( sbegin, send ), ranks );
+      }
+    }
+    std::sort( ranks.begin(), ranks.end() );
+    ranks.erase( std::unique( ranks.begin(), ranks.end() ), ranks.end() );
+
+    // the partition type or owner may only change at these ids
+    std::array< std::vector< int >, dimension > cuts;
+    for( int i = 0; i < dimension; ++i )
+    {
+      cuts[ i ] = { 2*localMesh.begin()[ i ], 2*localMesh.begin()[ i ]+1, 2*localMesh.end()[ i ], 2*localMesh.end()[ i ]+1, 2*globalMesh.end()[ i ] };
+      for( unsigned int rank : ranks )
+      {
+        const Mesh subMesh = gridLevel().subMesh( rank );
+        cuts[ i ].push_back( 2*subMesh.begin()[ i ] );
+        cuts[ i ].push_back( 2*subMesh.end()[ i ] );
+      }
+      std::sort( cuts[ i ].begin(), cuts[ i ].end() );
+      cuts[ i ].erase( std::unique( cuts[ i ].begin(), cuts[ i ].end() ), cuts[ i ].end() );
+    }
+
+    // cut each box into blocks, sorting them by codimension and key (interior, owned border, owner)
+    struct Entry
+    {
+      int codim;
+      unsigned long key;
+      Segment segment;
+    };
+    std::vector< Entry > entries;
+
+    boxes_.assign( offsets_.size(), std::array< Box, 1 << dimension >() );
+    for( typename PartitionList::Iterator pit = partitions().begin(); pit; ++pit )
+    {
+      const unsigned int number = pit->number();
+      for( unsigned int dir = 0; dir < (1 << dimension); ++dir )
+      {
+        Box &box = boxes_[ number - partitions().minNumber() ][ dir ];
+        std::size_t numBlocks = 1;
+        int codim = dimension;
+        for( int j = 0; j < dimension; ++j )
+        {
+          const int d = (dir >> j) & 1;
+          const int begin = pit->bound( 0, j, d );
+          const int end = pit->bound( 1, j, d );
+          box.cuts[ j ].assign( 1, begin );
+          for( int c : cuts[ j ] )
+          {
+            if( (c > begin) && (c <= end) )
+              box.cuts[ j ].push_back( c );
+          }
+          numBlocks *= box.cuts[ j ].size();
+          codim -= d;
+        }
+
+        box.blocks.resize( numBlocks );
+        for( std::size_t b = 0; b < numBlocks; ++b )
+        {
+          Block &block = box.blocks[ b ];
+          block.offset = 0;
+          bool empty = false;
+          std::size_t k = b;
+          for( int j = 0; j < dimension; ++j )
+          {
+            const int d = (dir >> j) & 1;
+            const std::size_t l = k % box.cuts[ j ].size();
+            k /= box.cuts[ j ].size();
+
+            const int first = box.cuts[ j ][ l ];
+            const int last = (l+1 < box.cuts[ j ].size() ? box.cuts[ j ][ l+1 ]-1 : pit->bound( 1, j, d ));
+            block.begin[ j ] = first + ((first ^ d) & 1);
+            block.width[ j ] = (last >= block.begin[ j ] ? (last - block.begin[ j ]) / 2 + 1 : 0);
+            empty |= (block.width[ j ] == 0);
+          }
+          if( empty )
+            continue;
+
+          unsigned long key = 0ul;
+          if( !interior.contains( block.begin, number ) )
+          {
+            const unsigned int rank = owner( block.begin );
+            const bool owned = (rank == localRank) && interiorBorder.contains( block.begin, number );
+            key = (owned ? 1ul : 2ul + rank);
+          }
+          entries.push_back( { codim, key, { 0, number, dir, b } } );
+        }
+      }
+    }
+
+    std::stable_sort( entries.begin(), entries.end(), [] ( const Entry &a, const Entry &b ) {
+        return (a.codim < b.codim) || ((a.codim == b.codim) && (a.key < b.key));
+      } );
+    IndexType offset[ dimension+1 ] = {};
+    for( int codim = 0; codim <= dimension; ++codim )
+      segments_[ codim ].clear();
+    for( Entry &entry : entries )
+    {
+      Segment &segment = entry.segment;
+      Block &block = boxes_[ segment.number - partitions().minNumber() ][ segment.dir ].blocks[ segment.block ];
+      block.offset = segment.offset = offset[ entry.codim ];
+      segments_[ entry.codim ].push_back( segment );
+
+      IndexType size = 1;
+      for( int j = 0; j < dimension; ++j )
+        size *= IndexType( block.width[ j ] );
+      offset[ entry.codim ] += size;
+    }
+    for( int codim = 0; codim <= dimension; ++codim )
+      assert( offset[ codim ] == size_[ codim ] );
+  }
+
+
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline unsigned int SPIndexSet< Grid, Ordering, pitype >::owner ( const MultiIndex &id ) const
+  {
+    // an entity belongs to the rank containing the cell above it (the last cell on the upper boundary)
+    const Mesh &globalMesh = gridLevel().globalMesh();
+    const MultiIndex &macroFactor = gridLevel().macroFactor();
+    MultiIndex begin, end;
+    for( int i = 0; i < dimension; ++i )
+    {
+      int c = id[ i ];
+      if( gridLevel().partitionPool().topology().hasNeighbor( 0, 2*i ) && (c == 2*globalMesh.end()[ i ]) )
+        c = 2*globalMesh.begin()[ i ];
+      begin[ i ] = std::min( c >> 1, globalMesh.end()[ i ]-1 ) / macroFactor[ i ];
+      end[ i ] = begin[ i ] + 1;
+    }
+
+    std::vector< unsigned int > ranks;
+    gridLevel().decomposition().intersect( Mesh( begin, end ), ranks );
+    assert( ranks.size() == 1u );
+    return ranks.front();
+  }
+
+
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >::blockIndex ( const MultiIndex &id, unsigned int number ) const
+  {
+    unsigned int dir = 0;
+    for( int j = 0; j < dimension; ++j )
+      dir |= ((id[ j ] & 1) << j);
+    const Box &box = boxes_[ number - partitions().minNumber() ][ dir ];
+
+    std::size_t b = 0, stride = 1;
+    for( int j = 0; j < dimension; ++j )
+    {
+      const std::vector< int > &cuts = box.cuts[ j ];
+      b += std::size_t( std::upper_bound( cuts.begin(), cuts.end(), id[ j ] ) - cuts.begin() - 1 ) * stride;
+      stride *= cuts.size();
+    }
+    const Block &block = box.blocks[ b ];
+
+    MultiIndex local;
+    for( int j = 0; j < dimension; ++j )
+      local[ j ] = (id[ j ] - block.begin[ j ]) >> 1;
+    return block.offset + Ordering::template index< IndexType >( local, block.width );
+  }
+
+
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >::index ( const MultiIndex &id, unsigned int number ) const
+  {
+    if( ownerFirst )
+      return blockIndex( id, number );
+
     const Partition &partition = partitions().partition( number );
 
-    IndexType index = 0;
-    IndexType factor = 1;
+    MultiIndex local, width;
     unsigned int dir = 0;
     for( int j = 0; j < dimension; ++j )
     {
@@ -144,21 +439,58 @@ namespace Dune
       const int begin = partition.bound( 0, j, d );
       const int end = partition.bound( 1, j, d );
 
-      const IndexType idLocal = (id[ j ] - begin) >> 1;
-      const IndexType width = ((end - begin) >> 1) + 1;
-      assert( (idLocal >= 0) && (idLocal < width) );
-      index += idLocal * factor;
+      local[ j ] = (id[ j ] - begin) >> 1;
+      width[ j ] = ((end - begin) >> 1) + 1;
+    }
+    return offsets_[ number - partitions().minNumber() ][ dir ] + Ordering::template index< IndexType >( local, width );
+  }
+
 
-      factor *= width;
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::MultiIndex
+  SPIndexSet< Grid, Ordering, pitype >::id ( int codim, IndexType index, unsigned int &number ) const
+  {
+    assert( (codim >= 0) && (codim <= dimension) && (index < size( codim )) );
+
+    // find the box (or block) containing the index
+    const std::vector< Segment > &segments = segments_[ codim ];
+    auto it = std::upper_bound( segments.begin(), segments.end(), index, [] ( IndexType index, const Segment &segment ) {
+        return (index < segment.offset);
+      } );
+    assert( it != segments.begin() );
+    const Segment &segment = *(--it);
+    number = segment.number;
+
+    MultiIndex begin, width;
+    if( ownerFirst )
+    {
+      const Block &block = boxes_[ number - partitions().minNumber() ][ segment.dir ].blocks[ segment.block ];
+      begin = block.begin;
+      width = block.width;
     }
-    return offsets_[ number - partitions().minNumber() ][ dir ] + index;
+    else
+    {
+      const Partition &partition = partitions().partition( number );
+      for( int j = 0; j < dimension; ++j )
+      {
+        const unsigned int d = (segment.dir >> j) & 1;
+        begin[ j ] = partition.bound( 0, j, d );
+        width[ j ] = ((partition.bound( 1, j, d ) - begin[ j ]) >> 1) + 1;
+      }
+    }
+
+    const MultiIndex local = Ordering::template local< IndexType >( index - segment.offset, width );
+    MultiIndex id;
+    for( int j = 0; j < dimension; ++j )
+      id[ j ] = begin[ j ] + 2*local[ j ];
+    return id;
   }
 
 
-  template< class Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   template< int cd >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >
     ::subIndex ( const MultiIndex &id, int i, int codim, unsigned int number, std::integral_constant< int, cd > ) const
   {
     const int mydim = dimension - cd;
@@ -172,17 +504,17 @@ namespace Dune
     return index( subId, number );
   }
 
-  template< class Grid >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >
     ::subIndex ( const MultiIndex &id, int i, int codim, unsigned int number, std::integral_constant< int, 0 > ) const
   {
     return index( id + gridLevel().referenceCube().subId( codim, i ), number );
   }
 
-  template< class Grid >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >
     ::subIndex ( const MultiIndex &id, int i, int codim, unsigned int number, std::integral_constant< int, dimension > ) const
   {
     assert( (codim == dimension) && (i == 0) );
@@ -190,19 +522,19 @@ namespace Dune
   }
 
 
-  template< class Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   template< class Entity >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >::index ( const Entity &entity ) const
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >::index ( const Entity &entity ) const
   {
     return index< Entity::codimension >( entity );
   }
 
 
-  template< class Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   template< int codim >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >::index ( const typename Codim< codim >::Entity &entity ) const
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >::index ( const typename Codim< codim >::Entity &entity ) const
   {
     assert( contains( entity ) );
     const typename Codim< codim >::EntityInfo &entityInfo
@@ -211,19 +543,19 @@ namespace Dune
   }
 
 
-  template< class Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   template< class Entity >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >::subIndex ( const Entity &entity, int i, unsigned int codim ) const
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >::subIndex ( const Entity &entity, int i, unsigned int codim ) const
   {
     return subIndex< Entity::codimension >( entity, i, codim );
   }
 
 
-  template< class Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   template< int cd >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >
     ::subIndex ( const typename Codim< cd >::Entity &entity, int i, unsigned int codim ) const
   {
     assert( contains( entity ) );
@@ -234,38 +566,54 @@ namespace Dune
   }
 
 
-  template< class Grid >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >::size ( const GeometryType &type ) const
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  template< int codim >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::template Codim< codim >::Entity
+  SPIndexSet< Grid, Ordering, pitype >::entity ( IndexType index ) const
+  {
+    typedef SPEntity< codim, dimension, Grid > EntityImpl;
+    typedef typename Codim< codim >::EntityInfo EntityInfo;
+
+    unsigned int number;
+    const MultiIndex id = this->id( codim, index, number );
+    return EntityImpl( EntityInfo( gridLevel(), id, number ) );
+  }
+
+
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >::size ( const GeometryType &type ) const
   {
     return (type.isCube() ? size( dimension - type.dim() ) : 0);
   }
 
 
-  template< class Grid >
-  inline typename SPIndexSet< Grid >::IndexType
-  SPIndexSet< Grid >::size ( const int codim ) const
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
+  inline typename SPIndexSet< Grid, Ordering, pitype >::IndexType
+  SPIndexSet< Grid, Ordering, pitype >::size ( const int codim ) const
   {
     assert( (codim >= 0) && (codim <= dimension) );
     return size_[ codim ];
   }
 
 
-  template< class Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   template< class Entity >
-  inline bool SPIndexSet< Grid >::contains ( const Entity &entity ) const
+  inline bool SPIndexSet< Grid, Ordering, pitype >::contains ( const Entity &entity ) const
   {
     return contains< Entity::codimension >( entity );
   }
 
 
-  template< class Grid >
+  template< class Grid, class Ordering, PartitionIteratorType pitype >
   template< int codim >
-  inline bool SPIndexSet< Grid >
+  inline bool SPIndexSet< Grid, Ordering, pitype >
     ::contains ( const typename Codim< codim >::Entity &entity ) const
   {
     const typename Codim< codim >::EntityInfo &entityInfo
       = entity.impl().entityInfo();
+    if( (pitype != All_Partition) && !partitions().contains( entityInfo.id(), entityInfo.partitionNumber() ) )
+      return false;
     assert( partitions().contains( entityInfo.partitionNumber() ) );
     return (&entityInfo.gridLevel() == &gridLevel());
   }
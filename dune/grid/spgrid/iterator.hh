@@ -7,6 +7,8 @@
 #include <dune/grid/spgrid/direction.hh>
 #include <dune/grid/spgrid/misc.hh>
 #include <dune/grid/spgrid/entity.hh>
+#include <dune/grid/spgrid/ordering.hh>
+#include <dune/grid/spgrid/traversal.hh>
 
 namespace Dune
 {
@@ -39,6 +41,8 @@ namespace Dune
 
     typedef typename EntityInfo::Direction Direction;
 
+    typedef SPTraversal< dimension > Traversal;
+
     static const unsigned int numDirections = GridLevel::numDirections;
 
     struct Begin {};
@@ -49,13 +53,18 @@ namespace Dune
 
     typedef SPDirectionIterator< dimension, codimension > DirectionIterator;
 
+    // note: the kind of traversal is determined once, so increment dispatches on a single value
+    enum Mode { Lexicographic, Tiled, Morton, Colored };
+
+    static Mode mode ( const Traversal &traversal );
+
   public:
     SPPartitionIterator () = default;
 
     SPPartitionIterator ( const GridLevel &gridLevel, const PartitionList &partitionList,
-                          const Begin &b, const unsigned int sweepDir = 0 );
+                          const Begin &b, const Traversal &traversal = Traversal() );
     SPPartitionIterator ( const GridLevel &gridLevel, const PartitionList &partitionList,
-                          const End &e, const unsigned int sweepDir = 0 );
+                          const End &e, const Traversal &traversal = Traversal() );
 
     operator bool () const { return bool( partition_ ); }
 
@@ -80,13 +89,33 @@ namespace Dune
   private:
     int begin ( int i, Direction dir ) const;
     int end ( int i, Direction dir ) const;
+    int tileEnd ( int i, Direction dir ) const;
+
+    int step ( int i ) const { return 2 - 4*int( traversal_.sweepDirection( i ) ); }
+    bool inside ( int i, Direction dir, int x ) const;
+
+    void incrementTiled ();
+    void incrementMorton ();
+    void incrementColored ();
+    void nextDirection ( Direction dir );
 
     void init ();
+    bool initDirection ( Direction dir );
+    void initTile ( Direction dir );
+
+    int firstColored ( int i, Direction dir ) const;
+    bool initColored ( Direction dir );
+    bool nextColored ( Direction dir, int i );
 
   private:
     EntityInfo entityInfo_;
     typename PartitionList::Iterator partition_;
-    unsigned int sweepDirection_;
+    Traversal traversal_;
+    Mode mode_ = Lexicographic;
+
+    // note: only used by tiled or serpentine traversals
+    MultiIndex tileBegin_;
+    unsigned int reversed_ = 0;
   };
 
 
@@ -97,12 +126,13 @@ namespace Dune
   template< int codim, class Grid >
   inline SPPartitionIterator< codim, Grid >
     ::SPPartitionIterator ( const GridLevel &gridLevel, const PartitionList &partitionList,
-                            const Begin &b, unsigned int sweepDir )
+                            const Begin &b, const Traversal &traversal )
     : entityInfo_( gridLevel ),
       partition_( partitionList.begin() ),
-      sweepDirection_( sweepDir )
+      traversal_( traversal ),
+      mode_( mode( traversal ) )
   {
-    assert( sweepDir < numDirections );
+    assert( traversal.sweepDirection() < numDirections );
     init();
   }
 
@@ -110,23 +140,48 @@ namespace Dune
   template< int codim, class Grid >
   inline SPPartitionIterator< codim, Grid >
     ::SPPartitionIterator ( const GridLevel &gridLevel, const PartitionList &partitionList,
-                            const End &e, unsigned int sweepDir )
+                            const End &e, const Traversal &traversal )
     : entityInfo_( gridLevel ),
       partition_( partitionList.end() ),
-      sweepDirection_( sweepDir )
+      traversal_( traversal ),
+      mode_( mode( traversal ) )
   {
-    assert( sweepDir < numDirections );
+    assert( traversal.sweepDirection() < numDirections );
     init();
   }
 
 
+  template< int codim, class Grid >
+  inline typename SPPartitionIterator< codim, Grid >::Mode
+  SPPartitionIterator< codim, Grid >::mode ( const Traversal &traversal )
+  {
+    if( traversal.isMorton() )
+      return Morton;
+    if( traversal.isColored() )
+      return Colored;
+    return (traversal.isLexicographic() ? Lexicographic : Tiled);
+  }
+
+
   template< int codim, class Grid >
   inline void SPPartitionIterator< codim, Grid >::increment ()
   {
+    switch( mode_ )
+    {
+    case Tiled:
+      return incrementTiled();
+    case Morton:
+      return incrementMorton();
+    case Colored:
+      return incrementColored();
+    default:
+      break;
+    }
+
     MultiIndex &id = entityInfo().id();
     for( int i = 0; i < dimension; ++i )
     {
-      const unsigned int sweep = (sweepDirection_ >> i) & 1;
+      const unsigned int sweep = traversal_.sweepDirection( i );
       id[ i ] += (2 - 4*sweep);
       if( id[ i ] != end( i, entityInfo().direction() ) )
         return entityInfo().update();
@@ -151,10 +206,113 @@ namespace Dune
   }
 
 
+  template< int codim, class Grid >
+  inline void SPPartitionIterator< codim, Grid >::incrementTiled ()
+  {
+    const Direction dir = entityInfo().direction();
+
+    // advance within the current tile
+    MultiIndex &id = entityInfo().id();
+    for( int i = 0; i < dimension; ++i )
+    {
+      const int step = 2 - 4*int( traversal_.sweepDirection( i ) );
+      const int first = tileBegin_[ i ];
+      const int last = tileEnd( i, dir ) - step;
+      if( (reversed_ >> i) & 1 )
+      {
+        if( id[ i ] != first )
+        {
+          id[ i ] -= step;
+          return entityInfo().update();
+        }
+      }
+      else if( id[ i ] != last )
+      {
+        id[ i ] += step;
+        return entityInfo().update();
+      }
+
+      // in serpentine order, the axis stays at its last entity and reverses
+      if( traversal_.isSerpentine() )
+        reversed_ ^= (1u << i);
+      else
+        id[ i ] = first;
+    }
+
+    // advance to the next tile
+    for( int i = 0; i < dimension; ++i )
+    {
+      tileBegin_[ i ] = tileEnd( i, dir );
+      if( tileBegin_[ i ] != end( i, dir ) )
+      {
+        reversed_ = 0;
+        id = tileBegin_;
+        return entityInfo().update();
+      }
+      tileBegin_[ i ] = begin( i, dir );
+    }
+
+    nextDirection( dir );
+  }
+
+
+  template< int codim, class Grid >
+  inline void SPPartitionIterator< codim, Grid >::incrementMorton ()
+  {
+    const Direction dir = entityInfo().direction();
+
+    // note: the local coordinates respect the sweep direction
+    MultiIndex &id = entityInfo().id();
+    MultiIndex local, width;
+    for( int i = 0; i < dimension; ++i )
+    {
+      const int step = 2 - 4*int( traversal_.sweepDirection( i ) );
+      local[ i ] = (id[ i ] - begin( i, dir )) / step;
+      width[ i ] = (end( i, dir ) - begin( i, dir )) / step;
+    }
+
+    if( SPMortonOrdering::next( local, width ) )
+    {
+      for( int i = 0; i < dimension; ++i )
+        id[ i ] = begin( i, dir ) + (2 - 4*int( traversal_.sweepDirection( i ) )) * local[ i ];
+      return entityInfo().update();
+    }
+
+    nextDirection( dir );
+  }
+
+
+  template< int codim, class Grid >
+  inline void SPPartitionIterator< codim, Grid >::incrementColored ()
+  {
+    const Direction dir = entityInfo().direction();
+    if( nextColored( dir, 0 ) )
+      return entityInfo().update();
+    nextDirection( dir );
+  }
+
+
+  template< int codim, class Grid >
+  inline void SPPartitionIterator< codim, Grid >::nextDirection ( Direction dir )
+  {
+    DirectionIterator dirIt( dir );
+    ++dirIt;
+    for( ; dirIt && !initDirection( *dirIt ); ++dirIt )
+      continue;
+    if( dirIt )
+      entityInfo().update();
+    else
+    {
+      ++partition_;
+      init();
+    }
+  }
+
+
   template< int codim, class Grid >
   inline int SPPartitionIterator< codim, Grid >::begin ( int i, Direction dir ) const
   {
-    const unsigned int s = (sweepDirection_ >> i) & 1;
+    const unsigned int s = traversal_.sweepDirection( i );
     return partition_->bound( s, i, dir[ i ] );
   }
 
@@ -162,12 +320,32 @@ namespace Dune
   template< int codim, class Grid >
   inline int SPPartitionIterator< codim, Grid >::end ( int i, Direction dir ) const
   {
-    const unsigned int s = (sweepDirection_ >> i) & 1;
+    const unsigned int s = traversal_.sweepDirection( i );
     const int bnd = partition_->bound( 1-s, i, dir[ i ] );
     return bnd + 2*(2*(1-s) - 1);
   }
 
 
+  template< int codim, class Grid >
+  inline bool SPPartitionIterator< codim, Grid >::inside ( int i, Direction dir, int x ) const
+  {
+    return (traversal_.sweepDirection( i ) == 0 ? x < end( i, dir ) : x > end( i, dir ));
+  }
+
+
+  template< int codim, class Grid >
+  inline int SPPartitionIterator< codim, Grid >::tileEnd ( int i, Direction dir ) const
+  {
+    const int tile = traversal_.tile( i );
+    if( tile == 0 )
+      return end( i, dir );
+    if( traversal_.sweepDirection( i ) == 0 )
+      return std::min( tileBegin_[ i ] + 2*tile, end( i, dir ) );
+    else
+      return std::max( tileBegin_[ i ] - 2*tile, end( i, dir ) );
+  }
+
+
   template< int codim, class Grid >
   inline void SPPartitionIterator< codim, Grid >::init ()
   {
@@ -175,14 +353,10 @@ namespace Dune
     if( partition_ )
     {
       DirectionIterator dirIt;
-      for( ; dirIt && partition_->empty( *dirIt ); ++dirIt )
+      for( ; dirIt && !initDirection( *dirIt ); ++dirIt )
         continue;
       if( dirIt )
-      {
-        for( int i = 0; i < dimension; ++i )
-          id[ i ] = begin( i, *dirIt );
         entityInfo().update( partition_->number() );
-      }
       else
       {
         ++partition_;
@@ -193,6 +367,88 @@ namespace Dune
       std::fill( id.begin(), id.end(), std::numeric_limits< int >::max() );
   }
 
+
+  template< int codim, class Grid >
+  inline bool SPPartitionIterator< codim, Grid >::initDirection ( Direction dir )
+  {
+    if( partition_->empty( dir ) )
+      return false;
+    initTile( dir );
+    return (mode_ != Colored) || initColored( dir );
+  }
+
+
+  template< int codim, class Grid >
+  inline void SPPartitionIterator< codim, Grid >::initTile ( Direction dir )
+  {
+    MultiIndex &id = entityInfo().id();
+    for( int i = 0; i < dimension; ++i )
+      id[ i ] = begin( i, dir );
+    tileBegin_ = id;
+    reversed_ = 0;
+  }
+
+
+  template< int codim, class Grid >
+  inline int SPPartitionIterator< codim, Grid >::firstColored ( int i, Direction dir ) const
+  {
+    // note: The red-black color depends on all coordinates; it is adjusted
+    //       along the first axis only, the other coordinates being set.
+    MultiIndex id = entityInfo().id();
+    id[ i ] = begin( i, dir );
+    if( traversal_.numColors() == 2u )
+      return (i > 0 || traversal_.color( id ) == traversal_.color() ? id[ i ] : id[ i ] + step( i ));
+    else
+      return (((id[ i ] >> 1) & 1) == int( (traversal_.color() >> i) & 1 ) ? id[ i ] : id[ i ] + step( i ));
+  }
+
+
+  template< int codim, class Grid >
+  inline bool SPPartitionIterator< codim, Grid >::initColored ( Direction dir )
+  {
+    MultiIndex &id = entityInfo().id();
+    for( int i = dimension-1; i >= 0; --i )
+    {
+      id[ i ] = firstColored( i, dir );
+      if( !inside( i, dir, id[ i ] ) )
+        return (traversal_.numColors() == 2u) && (i == 0) && nextColored( dir, 1 );
+    }
+    return true;
+  }
+
+
+  template< int codim, class Grid >
+  inline bool SPPartitionIterator< codim, Grid >::nextColored ( Direction dir, int i )
+  {
+    // note: Within a color class, the entities are two steps apart along
+    //       each axis (only along the first one for red-black colorings).
+    const bool redBlack = (traversal_.numColors() == 2u);
+    MultiIndex &id = entityInfo().id();
+    while( i < dimension )
+    {
+      id[ i ] += (redBlack && (i > 0) ? step( i ) : 2*step( i ));
+      if( !inside( i, dir, id[ i ] ) )
+      {
+        id[ i ] = firstColored( i, dir );
+        ++i;
+        continue;
+      }
+
+      if( redBlack && (i > 0) )
+      {
+        id[ 0 ] = firstColored( 0, dir );
+        if( !inside( 0, dir, id[ 0 ] ) )
+        {
+          // the row contains a single entity of the other color
+          i = 1;
+          continue;
+        }
+      }
+      return true;
+    }
+    return false;
+  }
+
 } // namespace Dune
 
 #endif // #ifndef DUNE_SPGRID_ITERATOR_HH
@@ -1,8 +1,15 @@
 #ifndef DUNE_SPGRID_LINKAGE_HH
 #define DUNE_SPGRID_LINKAGE_HH
 
+#include <cstddef>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
 #include <vector>
 
+#include <dune/grid/spgrid/decomposition.hh>
 #include <dune/grid/spgrid/partitionlist.hh>
 #include <dune/grid/spgrid/partitionpool.hh>
 
@@ -12,12 +19,24 @@ namespace Dune
   // SPLinkage
   // ---------
 
+  /**
+   * \brief communication interfaces of a grid level
+   *
+   * The interfaces are built on first request (in a thread safe manner) and
+   * cached afterwards. Only the neighboring ranks are determined on
+   * construction. Their partition pools are built once, when the first
+   * interface is requested, and shared by all interfaces. They are released
+   * as soon as all interfaces have been built.
+   */
   template< int dim >
   class SPLinkage
   {
     typedef SPLinkage< dim > This;
 
   public:
+    static const int dimension = dim;
+
+    typedef SPDecomposition< dim > Decomposition;
     typedef SPPartitionPool< dim > PartitionPool;
     typedef SPPartitionList< dim > PartitionList;
 
@@ -30,18 +49,101 @@ namespace Dune
                 const PartitionPool &localPool,
                 const std::vector< Mesh > &decomposition );
 
+    /**
+     * \brief construct linkage from a decomposition tree
+     *
+     * Instead of intersecting with all remote ranks, the decomposition is
+     * searched for sub-meshes close enough to the local one to share
+     * entities. Only for these ranks, partition pools are built.
+     *
+     * \param[in]  localRank      rank of this process
+     * \param[in]  localPool      partition pool of this process
+     * \param[in]  decomposition  decomposition of the macro mesh
+     * \param[in]  factor         refinement factor of this level with respect
+     *                            to the macro mesh
+     */
+    SPLinkage ( const int localRank,
+                const PartitionPool &localPool,
+                const Decomposition &decomposition,
+                const MultiIndex &factor );
+
+    /**
+     * \brief construct linkage of a refined level
+     *
+     * The partitions of a refined level are the refined partitions of its
+     * father level. So are the communication interfaces.
+     *
+     * \param[in]  localRank   rank of this process
+     * \param[in]  localPool   partition pool of this process
+     * \param[in]  father      linkage of the father level
+     * \param[in]  refinement  refinement from the father level to this one
+     *
+     * \note The father linkage must outlive this one.
+     */
+    template< class Refinement >
+    SPLinkage ( const int localRank,
+                const PartitionPool &localPool,
+                const This &father,
+                const Refinement &refinement );
+
+    /** \brief construct linkage with the neighbors of another one, but a different partition pool */
+    SPLinkage ( const This &other, const PartitionPool &localPool );
+
+    SPLinkage ( const This & ) = delete;
+    This &operator= ( const This & ) = delete;
+
     const Interface &interface ( const InterfaceType iftype ) const;
 
+    /**
+     * \brief stop deriving the interfaces from the father linkage
+     *
+     * Interfaces not built so far will be computed from the neighbors, so
+     * the father linkage may be destroyed afterwards.
+     */
+    void detach () { father_ = nullptr; }
+
   private:
+    struct Factor
+    {
+      static const int dimension = dim;
+
+      unsigned int factor ( const int i ) const { return factor_[ i ]; }
+
+      MultiIndex factor_;
+    };
+
+    const std::vector< PartitionPool > &remotePools () const;
+
+    template< InterfaceType iftype >
+    void build () const;
+
     template< InterfaceType iftype >
-    bool build ( const int localRank, const PartitionPool &localPool,
-                 const int remoteRank, const PartitionPool &remotePool );
+    bool build ( const int remoteRank, const PartitionPool &remotePool ) const;
 
    const PartitionList *
    intersect ( const bool order, const PartitionList &local, const PartitionList &remote ) const;
 
+    template< class Refinement >
+    static const PartitionList *refine ( const PartitionList &list, const Refinement &refinement );
+
+    static Mesh refine ( const Mesh &mesh, const MultiIndex &factor );
+    static Mesh coarsen ( const Mesh &mesh, const MultiIndex &factor );
+
+    int localRank_;
+    const PartitionPool *localPool_;
+    std::vector< std::pair< int, Mesh > > neighbors_;
+
+    const This *father_;
+    Factor factor_;
+
+    // note: The partition pools of the neighbors are shared by all interfaces.
+    mutable std::once_flag remotePoolsBuilt_;
+    mutable std::vector< PartitionPool > remotePools_;
+    mutable std::atomic< int > numBuilt_ = { 0 };
+
     // note: We use the knowledge that interfaces are numbered 0, ..., 4.
-    Interface interface_[ 5 ];
+    mutable std::once_flag built_[ 5 ];
+    mutable Interface interface_[ 5 ];
   };
 
 
@@ -155,47 +257,185 @@ namespace Dune
     ::SPLinkage ( const int localRank,
                   const PartitionPool &localPool,
                   const std::vector< Mesh > &decomposition )
+  : localRank_( localRank ),
+    localPool_( &localPool ),
+    father_( nullptr )
   {
     const int size = decomposition.size();
+    for( int remoteRank = 0; remoteRank < size; ++remoteRank )
+    {
+      if( remoteRank != localRank )
+        neighbors_.emplace_back( remoteRank, decomposition[ remoteRank ] );
+    }
+  }
 
+
+  template< int dim >
+  inline SPLinkage< dim >
+    ::SPLinkage ( const int localRank,
+                  const PartitionPool &localPool,
+                  const Decomposition &decomposition,
+                  const MultiIndex &factor )
+  : localRank_( localRank ),
+    localPool_( &localPool ),
+    father_( nullptr )
+  {
     const Mesh &globalMesh = localPool.globalMesh();
-    const MultiIndex &overlap = localPool.overlap();
+    const MultiIndex globalWidth = globalMesh.width();
 
-    for( int remoteRank = 0; remoteRank < size; ++remoteRank )
+    // All partitions of sub-meshes at most 2*overlap apart may intersect
+    MultiIndex distance = 2*localPool.overlap();
+    for( int i = 0; i < dimension; ++i )
+      ++distance[ i ];
+    std::vector< Mesh > neighborhood( 1, refine( decomposition.subMesh( localRank ), factor ).grow( distance ) );
+
+    // add periodic images of the neighborhood
+    for( int i = 0; i < dimension; ++i )
     {
-      if( remoteRank == localRank )
+      if( !localPool.topology().hasNeighbor( 0, 2*i ) )
         continue;
-      PartitionPool remotePool( decomposition[ remoteRank ], globalMesh, overlap, localPool.topology() );
-      if( build< All_All_Interface >( localRank, localPool, remoteRank, remotePool ) )
+
+      MultiIndex shift = MultiIndex::zero();
+      shift[ i ] = globalWidth[ i ];
+      const std::size_t size = neighborhood.size();
+      for( std::size_t k = 0; k < size; ++k )
       {
-        build< InteriorBorder_InteriorBorder_Interface >( localRank, localPool, remoteRank, remotePool );
-        build< InteriorBorder_All_Interface >( localRank, localPool, remoteRank, remotePool );
-        build< Overlap_OverlapFront_Interface >( localRank, localPool, remoteRank, remotePool );
-        build< Overlap_All_Interface >( localRank, localPool, remoteRank, remotePool );
+        const Mesh mesh = neighborhood[ k ];
+        if( mesh.begin()[ i ] < globalMesh.begin()[ i ] )
+          neighborhood.push_back( mesh + shift );
+        if( mesh.end()[ i ] > globalMesh.end()[ i ] )
+          neighborhood.push_back( mesh - shift );
       }
     }
+
+    std::vector< unsigned int > remoteRanks;
+    for( const Mesh &mesh : neighborhood )
+      decomposition.intersect( coarsen( mesh, factor ), remoteRanks );
+    std::sort( remoteRanks.begin(), remoteRanks.end() );
+    remoteRanks.erase( std::unique( remoteRanks.begin(), remoteRanks.end() ), remoteRanks.end() );
+
+    for( const unsigned int remoteRank : remoteRanks )
+    {
+      if( int( remoteRank ) != localRank )
+        neighbors_.emplace_back( remoteRank, refine( decomposition.subMesh( remoteRank ), factor ) );
+    }
   }
 
 
+  template< int dim >
+  template< class Refinement >
+  inline SPLinkage< dim >
+    ::SPLinkage ( const int localRank,
+                  const PartitionPool &localPool,
+                  const This &father,
+                  const Refinement &refinement )
+  : localRank_( localRank ),
+    localPool_( &localPool ),
+    father_( &father )
+  {
+    for( int i = 0; i < dimension; ++i )
+      factor_.factor_[ i ] = refinement.factor( i );
+
+    neighbors_.reserve( father.neighbors_.size() );
+    for( const auto &neighbor : father.neighbors_ )
+      neighbors_.emplace_back( neighbor.first, neighbor.second.refine( refinement ) );
+  }
+
+
+  template< int dim >
+  inline SPLinkage< dim >::SPLinkage ( const This &other, const PartitionPool &localPool )
+  : localRank_( other.localRank_ ),
+    localPool_( &localPool ),
+    neighbors_( other.neighbors_ ),
+    father_( other.father_ ),
+    factor_( other.factor_ )
+  {}
+
+
   template< int dim >
   inline const typename SPLinkage< dim >::Interface &
   SPLinkage< dim >::interface ( const InterfaceType iftype ) const
   {
-    assert( (int( iftype ) >= 0) && (int( iftype ) < 5) );
+    switch( iftype )
+    {
+    case InteriorBorder_InteriorBorder_Interface:
+      std::call_once( built_[ iftype ], [ this ] () { build< InteriorBorder_InteriorBorder_Interface >(); } );
+      break;
+
+    case InteriorBorder_All_Interface:
+      std::call_once( built_[ iftype ], [ this ] () { build< InteriorBorder_All_Interface >(); } );
+      break;
+
+    case Overlap_OverlapFront_Interface:
+      std::call_once( built_[ iftype ], [ this ] () { build< Overlap_OverlapFront_Interface >(); } );
+      break;
+
+    case Overlap_All_Interface:
+      std::call_once( built_[ iftype ], [ this ] () { build< Overlap_All_Interface >(); } );
+      break;
+
+    case All_All_Interface:
+      std::call_once( built_[ iftype ], [ this ] () { build< All_All_Interface >(); } );
+      break;
+
+    default:
+      DUNE_THROW( GridError, "No such InterfaceType." );
+    }
     return interface_[ int( iftype ) ];
   }
 
 
+  template< int dim >
+  inline const std::vector< typename SPLinkage< dim >::PartitionPool > &
+  SPLinkage< dim >::remotePools () const
+  {
+    std::call_once( remotePoolsBuilt_, [ this ] () {
+        remotePools_.reserve( neighbors_.size() );
+        for( const auto &neighbor : neighbors_ )
+          remotePools_.emplace_back( neighbor.second, localPool_->globalMesh(), localPool_->overlap(), localPool_->topology() );
+      } );
+    return remotePools_;
+  }
+
+
+  template< int dim >
+  template< InterfaceType iftype >
+  inline void SPLinkage< dim >::build () const
+  {
+    if( father_ )
+    {
+      for( const auto &node : father_->interface( iftype ) )
+      {
+        const PartitionList *sendList = refine( node.sendList(), factor_ );
+        const PartitionList *receiveList = sendList;
+        if( &node.receiveList() != &node.sendList() )
+          receiveList = refine( node.receiveList(), factor_ );
+        interface_[ iftype ].add( node.rank(), sendList, receiveList );
+      }
+    }
+    else
+    {
+      const std::vector< PartitionPool > &remotePools = this->remotePools();
+      for( std::size_t k = 0; k < neighbors_.size(); ++k )
+        build< iftype >( neighbors_[ k ].first, remotePools[ k ] );
+
+      // the last interface built releases the remote partition pools
+      if( ++numBuilt_ == 5 )
+        std::vector< PartitionPool >().swap( remotePools_ );
+    }
+  }
+
+
   template< int dim >
   template< InterfaceType iftype >
   inline bool SPLinkage< dim >
-    ::build ( const int localRank, const PartitionPool &localPool,
-              const int remoteRank, const PartitionPool &remotePool )
+    ::build ( const int remoteRank, const PartitionPool &remotePool ) const
   {
     const PartitionIteratorType piSend = SPCommunicationInterface< iftype >::sendPartition;
     const PartitionIteratorType piReceive = SPCommunicationInterface< iftype >::receivePartition;
 
-    const bool order = (localRank < remoteRank);
+    const bool order = (localRank_ < remoteRank);
+    const PartitionPool &localPool = *localPool_;
 
     // build intersection lists
     const PartitionList *sendList, *receiveList;
@@ -245,6 +485,50 @@ namespace Dune
   }
 
 
+  template< int dim >
+  template< class Refinement >
+  inline const typename SPLinkage< dim >::PartitionList *
+  SPLinkage< dim >::refine ( const PartitionList &list, const Refinement &refinement )
+  {
+    typedef typename PartitionList::Partition Partition;
+
+    PartitionList *link = new PartitionList;
+    for( typename PartitionList::Iterator it = list.begin(); it; ++it )
+      *link += Partition( it->refine( refinement ), it->number() );
+    return link;
+  }
+
+
+  template< int dim >
+  inline typename SPLinkage< dim >::Mesh
+  SPLinkage< dim >::refine ( const Mesh &mesh, const MultiIndex &factor )
+  {
+    MultiIndex begin, end;
+    for( int i = 0; i < dimension; ++i )
+    {
+      begin[ i ] = factor[ i ] * mesh.begin()[ i ];
+      end[ i ] = factor[ i ] * mesh.end()[ i ];
+    }
+    return Mesh( begin, end );
+  }
+
+
+  template< int dim >
+  inline typename SPLinkage< dim >::Mesh
+  SPLinkage< dim >::coarsen ( const Mesh &mesh, const MultiIndex &factor )
+  {
+    // round outwards, i.e., begin towards -infinity and end towards +infinity
+    MultiIndex begin, end;
+    for( int i = 0; i < dimension; ++i )
+    {
+      const int b = mesh.begin()[ i ], e = mesh.end()[ i ];
+      begin[ i ] = (b >= 0 ? b / factor[ i ] : -((factor[ i ] - 1 - b) / factor[ i ]));
+      end[ i ] = (e >= 0 ? (e + factor[ i ] - 1) / factor[ i ] : -((-e) / factor[ i ]));
+    }
+    return Mesh( begin, end );
+  }
+
+
 
   // Implementation of SPLinkage::Interface
   // --------------------------------------
@@ -53,7 +53,7 @@ namespace Dune
 
     std::pair< This, This > split ( const int dir, const int leftWeight, const int rightWeight ) const;
 
-    int volume () const;
+    long volume () const;
 
     MultiIndex width () const;
     int width ( const int i ) const;
@@ -180,10 +180,10 @@ namespace Dune
 
 
   template< int dim >
-  inline int SPMesh< dim >::volume () const
+  inline long SPMesh< dim >::volume () const
   {
     const MultiIndex &w = width();
-    int volume = 1;
+    long volume = 1;
     for( int i = 0; i < dimension; ++i )
       volume *= w[ i ];
     return volume;
@@ -22,6 +22,8 @@ namespace Dune
   {
     typedef SPBasicPackedMessageWriteBuffer This;
 
+    friend class SPBasicPackedMessageReadBuffer;
+
   public:
     SPBasicPackedMessageWriteBuffer () { initialize(); }
 
@@ -140,6 +142,14 @@ namespace Dune
   public:
     SPBasicPackedMessageReadBuffer () { initialize(); }
 
+    /** \brief read back the data written to a (local) write buffer */
+    explicit SPBasicPackedMessageReadBuffer ( SPBasicPackedMessageWriteBuffer &&writeBuffer )
+      : buffer_( writeBuffer.buffer_ ),
+        position_( 0 ), size_( writeBuffer.position_ )
+    {
+      writeBuffer.initialize();
+    }
+
     SPBasicPackedMessageReadBuffer ( const This & ) = delete;
 
     SPBasicPackedMessageReadBuffer ( This &&other )
@@ -0,0 +1,384 @@
+#ifndef DUNE_SPGRID_MIGRATION_HH
+#define DUNE_SPGRID_MIGRATION_HH
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/grid/common/exceptions.hh>
+#include <dune/grid/common/datahandleif.hh>
+
+#include <dune/grid/spgrid/communication.hh>
+#include <dune/grid/spgrid/iterator.hh>
+#include <dune/grid/spgrid/messagebuffer.hh>
+
+namespace Dune
+{
+
+  namespace __SPGrid
+  {
+
+    // resizeDataHandle
+    // ----------------
+
+    // note: calls dataHandle.resize(), if the data handle provides this method
+    template< class DataHandle >
+    inline auto resizeDataHandle ( DataHandle &dataHandle, int ) -> decltype( dataHandle.resize() )
+    {
+      return dataHandle.resize();
+    }
+
+    template< class DataHandle >
+    inline void resizeDataHandle ( DataHandle &dataHandle, long )
+    {}
+
+    template< class DataHandle >
+    inline void resizeDataHandle ( DataHandle &dataHandle )
+    {
+      resizeDataHandle( dataHandle, 0 );
+    }
+
+  } // namespace __SPGrid
+
+
+
+  // SPMigration
+  // -----------
+
+  /**
+   * \brief transfer of user data between two decompositions of a grid level
+   *
+   * On construction, the data attached to the InteriorBorder entities of the
+   * old grid level is gathered and sent to all ranks whose All partition
+   * (on the new grid level) contains these entities. On wait(), the
+   * received data is scattered to the entities of the new grid level.
+   *
+   * \note Border entities are received from all ranks sharing them, i.e.,
+   *       they may be scattered more than once.
+   */
+  template< class Grid, class DataHandle >
+  class SPMigration
+  {
+    typedef SPMigration< Grid, DataHandle > This;
+
+  public:
+    static const int dimension = Grid::dimension;
+
+    typedef SPGridLevel< Grid > GridLevel;
+
+    typedef typename GridLevel::Decomposition Decomposition;
+    typedef typename GridLevel::Mesh Mesh;
+    typedef typename GridLevel::PartitionPool PartitionPool;
+
+    typedef SPPartitionList< dimension > PartitionList;
+
+    typedef typename DataHandle::DataType DataType;
+
+  private:
+    typedef SPPackedMessageWriteBuffer< typename Grid::Communication > WriteBuffer;
+    typedef SPPackedMessageReadBuffer< typename Grid::Communication > ReadBuffer;
+
+  public:
+    SPMigration ( const GridLevel &oldLevel, const GridLevel &newLevel, DataHandle &dataHandle );
+
+    SPMigration ( const This & ) = delete;
+    This &operator= ( const This & ) = delete;
+
+    ~SPMigration () { wait(); }
+
+    bool ready () const { return ready_; }
+
+    void wait ();
+
+    /** \brief ranks (in another decomposition) sharing entities with the All partition of a grid level */
+    static std::vector< unsigned int >
+    ranks ( const GridLevel &gridLevel, const Decomposition &decomposition );
+
+    /** \brief InteriorBorder entities of the old grid level sent to a rank (numbered on the old grid level) */
+    static std::unique_ptr< PartitionList >
+    sendList ( const GridLevel &oldLevel, const GridLevel &newLevel, int rank );
+
+    /** \brief All entities of the new grid level received from a rank (numbered on the new grid level) */
+    static std::unique_ptr< PartitionList >
+    receiveList ( const GridLevel &oldLevel, const GridLevel &newLevel, int rank );
+
+    /** \brief partition pool of a rank in the decomposition of a grid level */
+    static PartitionPool
+    partitionPool ( const GridLevel &gridLevel, int rank );
+
+  private:
+
+    static std::unique_ptr< PartitionList >
+    intersect ( const PartitionList &interiorBorder, const PartitionList &all, bool local );
+
+    template< class Buffer >
+    void gather ( const GridLevel &gridLevel, Buffer &buffer, const PartitionList &partitionList ) const;
+
+    template< class Buffer >
+    void scatter ( Buffer &buffer, const PartitionList &partitionList ) const;
+
+    const GridLevel &newLevel_;
+    DataHandle &dataHandle_;
+    int tag_;
+    bool fixedSize_;
+    bool ready_;
+
+    std::unique_ptr< PartitionList > localList_;
+    SPBasicPackedMessageWriteBuffer localBuffer_;
+
+    std::vector< std::pair< int, std::unique_ptr< PartitionList > > > receiveLists_;
+    std::vector< WriteBuffer > writeBuffers_;
+  };
+
+
+
+  // Implementation of SPMigration
+  // -----------------------------
+
+  template< class Grid, class DataHandle >
+  inline SPMigration< Grid, DataHandle >
+    ::SPMigration ( const GridLevel &oldLevel, const GridLevel &newLevel, DataHandle &dataHandle )
+    : newLevel_( newLevel ),
+      dataHandle_( dataHandle ),
+      tag_( __SPGrid::getCommTag() ),
+      fixedSize_( true ),
+      ready_( false )
+  {
+    for( int codim = 0; codim <= dimension; ++codim )
+      fixedSize_ &= !dataHandle_.contains( dimension, codim ) || dataHandle_.fixedSize( dimension, codim );
+
+    const int localRank = oldLevel.grid().comm().rank();
+    const PartitionList &oldInteriorBorder = oldLevel.template partition< InteriorBorder_Partition >();
+    const PartitionList &newAll = newLevel.template partition< All_Partition >();
+
+    // remember, what to receive from which rank
+    for( const unsigned int rank : ranks( newLevel, oldLevel.decomposition() ) )
+    {
+      if( int( rank ) == localRank )
+        continue;
+      std::unique_ptr< PartitionList > receiveList = This::receiveList( oldLevel, newLevel, rank );
+      if( !receiveList->empty() )
+        receiveLists_.emplace_back( rank, std::move( receiveList ) );
+    }
+
+    // gather and send data
+    for( const unsigned int rank : ranks( oldLevel, newLevel.decomposition() ) )
+    {
+      if( int( rank ) == localRank )
+        continue;
+      const std::unique_ptr< PartitionList > sendList = This::sendList( oldLevel, newLevel, rank );
+      if( sendList->empty() )
+        continue;
+      writeBuffers_.emplace_back( oldLevel.grid().comm() );
+      gather( oldLevel, writeBuffers_.back(), *sendList );
+      writeBuffers_.back().send( rank, tag_ );
+    }
+
+    // gather data remaining on this rank
+    localList_ = intersect( oldInteriorBorder, newAll, false );
+    gather( oldLevel, localBuffer_, *intersect( oldInteriorBorder, newAll, true ) );
+  }
+
+
+  template< class Grid, class DataHandle >
+  inline void SPMigration< Grid, DataHandle >::wait ()
+  {
+    if( ready() )
+      return;
+    ready_ = true;
+
+    SPBasicPackedMessageReadBuffer localBuffer( std::move( localBuffer_ ) );
+    scatter( localBuffer, *localList_ );
+
+    std::vector< ReadBuffer > readBuffers;
+    readBuffers.reserve( receiveLists_.size() );
+    for( const auto &receiveList : receiveLists_ )
+    {
+      readBuffers.emplace_back( newLevel_.grid().comm() );
+      readBuffers.back().receive( receiveList.first, tag_ );
+    }
+
+    for( std::size_t i = 0; i < receiveLists_.size(); ++i )
+    {
+      const typename std::vector< ReadBuffer >::iterator buffer = waitAny( readBuffers );
+      for( const auto &receiveList : receiveLists_ )
+      {
+        if( receiveList.first == buffer->rank() )
+        {
+          scatter( *buffer, *receiveList.second );
+          break;
+        }
+      }
+    }
+
+    for( WriteBuffer &buffer : writeBuffers_ )
+      buffer.wait();
+    writeBuffers_.clear();
+  }
+
+
+  template< class Grid, class DataHandle >
+  inline std::vector< unsigned int > SPMigration< Grid, DataHandle >
+    ::ranks ( const GridLevel &gridLevel, const Decomposition &decomposition )
+  {
+    // The All partition contains all entities within the overlap of the
+    // local mesh (including periodic images), i.e., all ranks sharing
+    // entities with it have a sub-mesh touching one of its partitions (or
+    // a periodic image of them).
+    std::vector< unsigned int > ranks;
+    const PartitionList &all = gridLevel.template partition< All_Partition >();
+    const Mesh &macroMesh = decomposition.mesh();
+    const Mesh &globalMesh = gridLevel.globalMesh();
+    const typename Mesh::MultiIndex globalWidth = globalMesh.width();
+    for( typename PartitionList::Iterator it = all.begin(); it; ++it )
+    {
+      typename Mesh::MultiIndex begin, end;
+      for( int i = 0; i < dimension; ++i )
+      {
+        begin[ i ] = it->begin()[ i ] / 2 - 1;
+        end[ i ] = (it->end()[ i ] + 1) / 2 + 1;
+      }
+      std::vector< Mesh > boxes( 1, Mesh( begin, end ) );
+      for( int i = 0; i < dimension; ++i )
+      {
+        if( !gridLevel.domain().topology().hasNeighbor( 0, 2*i ) )
+          continue;
+
+        typename Mesh::MultiIndex shift = Mesh::MultiIndex::zero();
+        shift[ i ] = globalWidth[ i ];
+        const std::size_t size = boxes.size();
+        for( std::size_t k = 0; k < size; ++k )
+        {
+          const Mesh box = boxes[ k ];
+          if( box.begin()[ i ] < globalMesh.begin()[ i ] )
+            boxes.push_back( box + shift );
+          if( box.end()[ i ] > globalMesh.end()[ i ] )
+            boxes.push_back( box - shift );
+        }
+      }
+
+      for( const Mesh &box : boxes )
+      {
+        for( int i = 0; i < dimension; ++i )
+        {
+          const int factor = globalWidth[ i ] / macroMesh.width( i );
+          begin[ i ] = std::max( box.begin()[ i ], globalMesh.begin()[ i ] ) / factor;
+          end[ i ] = (std::min( box.end()[ i ], globalMesh.end()[ i ] ) + factor - 1) / factor;
+        }
+        decomposition.intersect( Mesh( begin, end ), ranks );
+      }
+    }
+    std::sort( ranks.begin(), ranks.end() );
+    ranks.erase( std::unique( ranks.begin(), ranks.end() ), ranks.end() );
+    return ranks;
+  }
+
+
+  template< class Grid, class DataHandle >
+  inline std::unique_ptr< typename SPMigration< Grid, DataHandle >::PartitionList >
+  SPMigration< Grid, DataHandle >
+    ::sendList ( const GridLevel &oldLevel, const GridLevel &newLevel, int rank )
+  {
+    const PartitionPool remotePool = partitionPool( newLevel, rank );
+    return intersect( oldLevel.template partition< InteriorBorder_Partition >(), remotePool.template get< All_Partition >(), true );
+  }
+
+
+  template< class Grid, class DataHandle >
+  inline std::unique_ptr< typename SPMigration< Grid, DataHandle >::PartitionList >
+  SPMigration< Grid, DataHandle >
+    ::receiveList ( const GridLevel &oldLevel, const GridLevel &newLevel, int rank )
+  {
+    const PartitionPool remotePool = partitionPool( oldLevel, rank );
+    return intersect( remotePool.template get< InteriorBorder_Partition >(), newLevel.template partition< All_Partition >(), false );
+  }
+
+
+  template< class Grid, class DataHandle >
+  inline typename SPMigration< Grid, DataHandle >::PartitionPool
+  SPMigration< Grid, DataHandle >::partitionPool ( const GridLevel &gridLevel, int rank )
+  {
+    const PartitionPool &localPool = gridLevel.partitionPool();
+    return PartitionPool( gridLevel.subMesh( rank ), localPool.globalMesh(), localPool.overlap(), localPool.topology() );
+  }
+
+
+  template< class Grid, class DataHandle >
+  inline std::unique_ptr< typename SPMigration< Grid, DataHandle >::PartitionList >
+  SPMigration< Grid, DataHandle >
+    ::intersect ( const PartitionList &interiorBorder, const PartitionList &all, bool local )
+  {
+    typedef typename PartitionList::Partition Partition;
+
+    // note: Both sides enumerate the intersections in the same order; the
+    //       partition number is taken from the local partition list.
+    std::unique_ptr< PartitionList > intersection( new PartitionList );
+    for( typename PartitionList::Iterator pit = interiorBorder.begin(); pit; ++pit )
+    {
+      for( typename PartitionList::Iterator qit = all.begin(); qit; ++qit )
+      {
+        const SPBasicPartition< dimension > box = pit->intersect( *qit );
+        if( !box.empty() )
+          *intersection += Partition( box, (local ? pit->number() : qit->number()) );
+      }
+    }
+    return intersection;
+  }
+
+
+  template< class Grid, class DataHandle >
+  template< class Buffer >
+  inline void SPMigration< Grid, DataHandle >
+    ::gather ( const GridLevel &gridLevel, Buffer &buffer, const PartitionList &partitionList ) const
+  {
+    Hybrid::forEach( std::make_integer_sequence< int, dimension+1 >(), [ this, &gridLevel, &buffer, &partitionList ] ( auto codim ) {
+        typedef SPPartitionIterator< codim, const Grid > Iterator;
+
+        if( !dataHandle_.contains( dimension, codim ) )
+          return;
+
+        const bool fixedSize = dataHandle_.fixedSize( dimension, codim );
+        const Iterator end( gridLevel, partitionList, typename Iterator::End() );
+        for( Iterator it( gridLevel, partitionList, typename Iterator::Begin() ); it != end; ++it )
+        {
+          const auto &entity = *it;
+          if( !fixedSize )
+            buffer.write( static_cast< int >( dataHandle_.size( entity ) ) );
+          dataHandle_.gather( buffer, entity );
+        }
+      } );
+  }
+
+
+  template< class Grid, class DataHandle >
+  template< class Buffer >
+  inline void SPMigration< Grid, DataHandle >
+    ::scatter ( Buffer &buffer, const PartitionList &partitionList ) const
+  {
+    Hybrid::forEach( std::make_integer_sequence< int, dimension+1 >(), [ this, &buffer, &partitionList ] ( auto codim ) {
+        typedef SPPartitionIterator< codim, const Grid > Iterator;
+
+        if( !dataHandle_.contains( dimension, codim ) )
+          return;
+
+        const bool fixedSize = dataHandle_.fixedSize( dimension, codim );
+        const Iterator end( newLevel_, partitionList, typename Iterator::End() );
+        for( Iterator it( newLevel_, partitionList, typename Iterator::Begin() ); it != end; ++it )
+        {
+          const auto &entity = *it;
+          int size;
+          if( !fixedSize )
+            buffer.read( size );
+          else
+            size = dataHandle_.size( entity );
+          dataHandle_.scatter( buffer, entity, size );
+        }
+      } );
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_MIGRATION_HH
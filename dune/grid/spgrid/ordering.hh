@@ -0,0 +1,305 @@
+#ifndef DUNE_SPGRID_ORDERING_HH
+#define DUNE_SPGRID_ORDERING_HH
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+
+#include <dune/grid/spgrid/multiindex.hh>
+
+namespace Dune
+{
+
+  // SPLexicographicOrdering
+  // -----------------------
+
+  /**
+   * \brief lexicographic ordering of the points in a box (first axis fastest)
+   *
+   * Orderings enumerate the points of a box [0, width) consecutively. They
+   * are used by SPIndexSet to number the entities of each partition and
+   * direction.
+   */
+  struct SPLexicographicOrdering
+  {
+    template< class IndexType, int dim >
+    static IndexType index ( const SPMultiIndex< dim > &local, const SPMultiIndex< dim > &width )
+    {
+      IndexType index = 0;
+      IndexType factor = 1;
+      for( int j = 0; j < dim; ++j )
+      {
+        assert( (local[ j ] >= 0) && (local[ j ] < width[ j ]) );
+        index += IndexType( local[ j ] ) * factor;
+        factor *= IndexType( width[ j ] );
+      }
+      return index;
+    }
+
+    /** \brief point with given index (inverse of index) */
+    template< class IndexType, int dim >
+    static SPMultiIndex< dim > local ( IndexType index, const SPMultiIndex< dim > &width )
+    {
+      SPMultiIndex< dim > local;
+      for( int j = 0; j < dim; ++j )
+      {
+        local[ j ] = int( index % IndexType( width[ j ] ) );
+        index /= IndexType( width[ j ] );
+      }
+      assert( index == 0 );
+      return local;
+    }
+  };
+
+
+
+  // SPMortonOrdering
+  // ----------------
+
+  /**
+   * \brief ordering of the points in a box along the Morton (Z-order) curve
+   *
+   * The Morton code interleaves the bits of the coordinates, the first axis
+   * being the least significant one. As the box need not be a power of two,
+   * the index of a point is its rank among the Morton codes of all points
+   * in the box. It is computed arithmetically by descending the (implicit)
+   * quadtree / octree, counting the points in all preceding blocks.
+   */
+  struct SPMortonOrdering
+  {
+    typedef std::uint64_t Code;
+
+    template< class IndexType, int dim >
+    static IndexType index ( const SPMultiIndex< dim > &local, const SPMultiIndex< dim > &width )
+    {
+      int lo[ dim ];
+      for( int j = 0; j < dim; ++j )
+      {
+        assert( (local[ j ] >= 0) && (local[ j ] < width[ j ]) );
+        lo[ j ] = 0;
+      }
+
+      IndexType index = 0;
+      for( int level = levels( width )-1; level >= 0; --level )
+      {
+        const int s = (1 << level);
+
+        // number of points in the lower / upper half of the current block
+        IndexType size[ dim ][ 2 ];
+        int child[ dim ];
+        for( int j = 0; j < dim; ++j )
+        {
+          size[ j ][ 0 ] = IndexType( std::max( std::min( lo[ j ] + s, width[ j ] ) - lo[ j ], 0 ) );
+          size[ j ][ 1 ] = IndexType( std::max( std::min( lo[ j ] + 2*s, width[ j ] ) - (lo[ j ] + s), 0 ) );
+          child[ j ] = (local[ j ] >> level) & 1;
+        }
+
+        // count the points in all children preceding the one containing local
+        // note: A child c' precedes c, if c'[ k ] < c[ k ] for the last
+        //       axis k where they differ.
+        for( int k = 0; k < dim; ++k )
+        {
+          if( child[ k ] == 0 )
+            continue;
+          IndexType count = size[ k ][ 0 ];
+          for( int j = 0; j < k; ++j )
+            count *= size[ j ][ 0 ] + size[ j ][ 1 ];
+          for( int j = k+1; j < dim; ++j )
+            count *= size[ j ][ child[ j ] ];
+          index += count;
+        }
+
+        for( int j = 0; j < dim; ++j )
+          lo[ j ] += child[ j ] * s;
+      }
+      return index;
+    }
+
+    /** \brief point with given index (inverse of index) */
+    template< class IndexType, int dim >
+    static SPMultiIndex< dim > local ( IndexType index, const SPMultiIndex< dim > &width )
+    {
+      SPMultiIndex< dim > local;
+      for( int level = levels( width )-1; level >= 0; --level )
+      {
+        const int s = (1 << level);
+
+        // skip the children (in Morton order) preceding the one containing the point
+        for( unsigned int c = 0; c < (1u << dim); ++c )
+        {
+          IndexType count = 1;
+          for( int j = 0; j < dim; ++j )
+          {
+            const int lo = local[ j ] + ((c >> j) & 1) * s;
+            count *= IndexType( std::max( std::min( lo + s, width[ j ] ) - lo, 0 ) );
+          }
+          if( index < count )
+          {
+            for( int j = 0; j < dim; ++j )
+              local[ j ] += ((c >> j) & 1) * s;
+            break;
+          }
+          index -= count;
+        }
+      }
+      assert( index == 0 );
+      return local;
+    }
+
+    /**
+     * \brief move to the next point of the box in Morton order
+     *
+     * \returns \b false, if local was the last point of the box
+     */
+    template< int dim >
+    static bool next ( SPMultiIndex< dim > &local, const SPMultiIndex< dim > &width )
+    {
+      const int bits = levels( width );
+      assert( bits*dim <= 64 );
+
+      SPMultiIndex< dim > last;
+      for( int j = 0; j < dim; ++j )
+        last[ j ] = width[ j ]-1;
+      const Code zmax = encode( last, bits );
+
+      Code z = encode( local, bits ) + 1;
+      if( z > zmax )
+        return false;
+      decode( z, bits, local );
+      if( contains( local, width ) )
+        return true;
+      if( !bigmin( z, zmax, bits, dim ) )
+        return false;
+      decode( z, bits, local );
+      return true;
+    }
+
+    template< int dim >
+    static Code encode ( const SPMultiIndex< dim > &local, int bits )
+    {
+      Code code = 0;
+      for( int level = 0; level < bits; ++level )
+      {
+        for( int j = 0; j < dim; ++j )
+          code |= Code( (local[ j ] >> level) & 1 ) << (level*dim + j);
+      }
+      return code;
+    }
+
+    template< int dim >
+    static void decode ( Code code, int bits, SPMultiIndex< dim > &local )
+    {
+      for( int j = 0; j < dim; ++j )
+        local[ j ] = 0;
+      for( int level = 0; level < bits; ++level )
+      {
+        for( int j = 0; j < dim; ++j )
+          local[ j ] |= int( (code >> (level*dim + j)) & 1 ) << level;
+      }
+    }
+
+  private:
+    template< int dim >
+    static int levels ( const SPMultiIndex< dim > &width )
+    {
+      const int w = *std::max_element( width.begin(), width.end() );
+      int levels = 0;
+      while( (1 << levels) < w )
+        ++levels;
+      return levels;
+    }
+
+    template< int dim >
+    static bool contains ( const SPMultiIndex< dim > &local, const SPMultiIndex< dim > &width )
+    {
+      bool contains = true;
+      for( int j = 0; j < dim; ++j )
+        contains &= (local[ j ] < width[ j ]);
+      return contains;
+    }
+
+    // set bit pos of code to value and all lower bits of the same axis to !value
+    static Code load ( Code code, int pos, bool value, int dim )
+    {
+      Code lower = 0;
+      for( int p = pos - dim; p >= 0; p -= dim )
+        lower |= (Code( 1 ) << p);
+      if( value )
+        return (code | (Code( 1 ) << pos)) & ~lower;
+      else
+        return (code & ~(Code( 1 ) << pos)) | lower;
+    }
+
+    // replace z (outside the box [0, zmax]) by the smallest code in the box greater than z
+    // note: This is the BIGMIN algorithm by Tropf and Herzog (1981).
+    static bool bigmin ( Code &z, Code zmax, int bits, int dim )
+    {
+      Code zmin = 0;
+      Code result = 0;
+      bool found = false;
+      for( int pos = bits*dim-1; pos >= 0; --pos )
+      {
+        const int b = int( (z >> pos) & 1 );
+        const int bmin = int( (zmin >> pos) & 1 );
+        const int bmax = int( (zmax >> pos) & 1 );
+        if( (b == 0) && (bmin == 0) && (bmax == 1) )
+        {
+          result = load( zmin, pos, true, dim );
+          found = true;
+          zmax = load( zmax, pos, false, dim );
+        }
+        else if( (b == 0) && (bmin == 1) )
+        {
+          z = zmin;
+          return true;
+        }
+        else if( (b == 1) && (bmax == 0) )
+        {
+          z = result;
+          return found;
+        }
+        else if( (b == 1) && (bmin == 0) )
+          zmin = load( zmin, pos, true, dim );
+      }
+      z = result;
+      return found;
+    }
+  };
+
+
+
+  // SPOwnerFirstOrdering
+  // --------------------
+
+  /**
+   * \brief ordering grouping the entities by owner
+   *
+   * SPIndexSet numbers the interior entities first, followed by the owned
+   * border entities and all remaining (border, overlap and front) entities
+   * grouped by the rank owning them. So the owned entities form the leading
+   * block of the index space, and the entities received from each neighbor
+   * form a contiguous slice.
+   *
+   * The entities are cut into boxes of equal owner, within which they are
+   * ordered by the given Ordering.
+   */
+  template< class Ordering = SPLexicographicOrdering >
+  struct SPOwnerFirstOrdering
+  {
+    template< class IndexType, int dim >
+    static IndexType index ( const SPMultiIndex< dim > &local, const SPMultiIndex< dim > &width )
+    {
+      return Ordering::template index< IndexType >( local, width );
+    }
+
+    template< class IndexType, int dim >
+    static SPMultiIndex< dim > local ( IndexType index, const SPMultiIndex< dim > &width )
+    {
+      return Ordering::template local< IndexType >( index, width );
+    }
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_ORDERING_HH
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <limits>
+#include <type_traits>
 
 #include <dune/common/iostream.hh>
 
@@ -49,12 +50,16 @@ namespace Dune
       return This( std::max( begin(), other.begin() ), std::min( end(), other.end() ) );
     }
 
+    template< class Refinement >
+    typename std::enable_if< Refinement::dimension == dim, This >::type
+    refine ( const Refinement &refinement ) const;
+
     bool contains ( const MultiIndex &id ) const;
 
     bool empty () const;
     bool empty ( Direction dir ) const;
 
-    int volume () const;
+    long volume () const;
     MultiIndex width () const;
     int width ( int i ) const { return std::max( (end()[ i ]+1)/2 - begin()[ i ]/2, 0 ); }
 
@@ -113,6 +118,23 @@ namespace Dune
   // Implementation of SPBasicPartition
   // ----------------------------------
 
+  template< int dim >
+  template< class Refinement >
+  inline typename std::enable_if< Refinement::dimension == dim, SPBasicPartition< dim > >::type
+  SPBasicPartition< dim >::refine ( const Refinement &refinement ) const
+  {
+    // even bounds are scaled; odd (open) bounds stay next to the scaled vertex
+    MultiIndex childBegin, childEnd;
+    for( int i = 0; i < dimension; ++i )
+    {
+      const int factor = refinement.factor( i );
+      childBegin[ i ] = factor * begin()[ i ] - (factor-1) * (begin()[ i ] & 1);
+      childEnd[ i ] = factor * end()[ i ] + (factor-1) * (end()[ i ] & 1);
+    }
+    return This( childBegin, childEnd );
+  }
+
+
   template< int dim >
   inline bool SPBasicPartition< dim >::contains ( const MultiIndex &id ) const
   {
@@ -144,9 +166,9 @@ namespace Dune
 
 
   template< int dim >
-  inline int SPBasicPartition< dim >::volume () const
+  inline long SPBasicPartition< dim >::volume () const
   {
-    int volume = 1;
+    long volume = 1;
     for( int i = 0; i < dimension; ++i )
       volume *= width( i );
     return volume;
@@ -57,7 +57,7 @@ namespace Dune
 
     bool contains ( const MultiIndex &id, unsigned int number ) const;
     const Partition *findPartition ( const MultiIndex &id ) const;
-    int volume () const;
+    long volume () const;
 
     bool empty () const { return !head_; }
     unsigned int size () const;
@@ -194,9 +194,9 @@ namespace Dune
 
 
   template< int dim >
-  inline int SPPartitionList< dim >::volume () const
+  inline long SPPartitionList< dim >::volume () const
   {
-    int volume = 0;
+    long volume = 0;
     for( const Node *it = head_; it; it = it->next() )
       volume += it->partition().volume();
     return volume;
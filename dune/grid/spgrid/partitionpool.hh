@@ -34,6 +34,19 @@ namespace Dune
     template< PartitionIteratorType pitype >
     const PartitionList &get () const;
 
+    /**
+     * \brief interior entities whose stencil of given width (in cells) only
+     *        touches interior entities
+     *
+     * Together with the shell, the deep interior partitions the interior.
+     * As it does not depend on overlap or border data, it can be processed
+     * while a communication is in progress.
+     */
+    SPPartitionList< dim > deepInterior ( const MultiIndex &width ) const;
+
+    /** \brief interior entities not contained in the deep interior */
+    SPPartitionList< dim > shell ( const MultiIndex &width ) const;
+
     template< int codim >
     PartitionType
     partitionType ( const MultiIndex &id, const unsigned int number ) const;
@@ -46,6 +59,7 @@ namespace Dune
     Partition makePartition ( const Mesh &localMesh, const unsigned int number,
                               const unsigned int open ) const;
 
+    Mesh localMesh_;
     Mesh globalMesh_;
     MultiIndex overlap_;
     Topology topology_;
@@ -67,7 +81,8 @@ namespace Dune
   inline SPPartitionPool< dim >
     ::SPPartitionPool ( const Mesh &localMesh, const Mesh &globalMesh,
                         const MultiIndex &overlap, const Topology &topology )
-  : globalMesh_( globalMesh ),
+  : localMesh_( localMesh ),
+    globalMesh_( globalMesh ),
     overlap_( overlap ),
     topology_( topology )
   {
@@ -171,6 +186,66 @@ namespace Dune
   }
 
 
+  template< int dim >
+  inline SPPartitionList< dim > SPPartitionPool< dim >::deepInterior ( const MultiIndex &width ) const
+  {
+    // shrink the local mesh on all sides with neighbors (including periodic ones)
+    MultiIndex begin = localMesh_.begin();
+    MultiIndex end = localMesh_.end();
+    bool empty = false;
+    for( int i = 0; i < dimension; ++i )
+    {
+      assert( width[ i ] >= 0 );
+      const bool periodic = topology().hasNeighbor( 0, 2*i );
+      if( periodic || (begin[ i ] != globalMesh().begin()[ i ]) )
+        begin[ i ] += width[ i ];
+      if( periodic || (end[ i ] != globalMesh().end()[ i ]) )
+        end[ i ] -= width[ i ];
+      empty |= (end[ i ] <= begin[ i ]);
+    }
+
+    SPPartitionList< dimension > deepInterior;
+    if( !empty )
+      deepInterior += makePartition( Mesh( begin, end ), 0, (1 << dimension) - 1 );
+    return deepInterior;
+  }
+
+
+  template< int dim >
+  inline SPPartitionList< dim > SPPartitionPool< dim >::shell ( const MultiIndex &width ) const
+  {
+    const SPPartitionList< dimension > deepInterior = this->deepInterior( width );
+    if( deepInterior.empty() )
+      return interiorList_;
+
+    // cut the interior into slabs around the deep interior
+    const Partition &interior = *interiorList_.begin();
+    const Partition &deep = *deepInterior.begin();
+    MultiIndex begin = interior.begin();
+    MultiIndex end = interior.end();
+
+    // note: All slabs belong to the partition with number 0 (as the interior).
+    SPPartitionList< dimension > shell;
+    for( int i = 0; i < dimension; ++i )
+    {
+      if( deep.begin()[ i ] > interior.begin()[ i ] )
+      {
+        end[ i ] = deep.begin()[ i ] - 1;
+        shell += Partition( begin, end, globalMesh(), 0 );
+      }
+      if( deep.end()[ i ] < interior.end()[ i ] )
+      {
+        begin[ i ] = deep.end()[ i ] + 1;
+        end[ i ] = interior.end()[ i ];
+        shell += Partition( begin, end, globalMesh(), 0 );
+      }
+      begin[ i ] = deep.begin()[ i ];
+      end[ i ] = deep.end()[ i ];
+    }
+    return shell;
+  }
+
+
   template< int dim >
   template< int codim >
   inline PartitionType
@@ -1,8 +1,10 @@
 #ifndef DUNE_SPGRID_PERSISTENTCONTAINER_HH
 #define DUNE_SPGRID_PERSISTENTCONTAINER_HH
 
+#include <cstddef>
 #include <vector>
 
+#include <dune/grid/common/datahandleif.hh>
 #include <dune/grid/utility/persistentcontainer.hh>
 #include <dune/grid/utility/persistentcontainervector.hh>
 
@@ -14,11 +16,11 @@ namespace Dune
   // PersistentContainer for SPGrid
   // ------------------------------
 
-  template< class ct, int dim, template< int > class Ref, class Comm, class T >
-  class PersistentContainer< SPGrid< ct, dim, Ref, Comm >, T >
-    : public PersistentContainerVector< SPGrid< ct, dim, Ref, Comm >, typename SPGrid< ct, dim, Ref, Comm >::HierarchicIndexSet, std::vector< T > >
+  template< class ct, int dim, template< int > class Ref, class Comm, class Index, class T >
+  class PersistentContainer< SPGrid< ct, dim, Ref, Comm, Index >, T >
+    : public PersistentContainerVector< SPGrid< ct, dim, Ref, Comm, Index >, typename SPGrid< ct, dim, Ref, Comm, Index >::HierarchicIndexSet, std::vector< T > >
   {
-    typedef PersistentContainerVector< SPGrid< ct, dim, Ref, Comm >, typename SPGrid< ct, dim, Ref, Comm >::HierarchicIndexSet, std::vector< T > > Base;
+    typedef PersistentContainerVector< SPGrid< ct, dim, Ref, Comm, Index >, typename SPGrid< ct, dim, Ref, Comm, Index >::HierarchicIndexSet, std::vector< T > > Base;
 
   public:
     typedef typename Base::Grid Grid;
@@ -29,6 +31,54 @@ namespace Dune
     {}
   };
 
+
+
+  // SPPersistentContainerDataHandle
+  // -------------------------------
+
+  /**
+   * \brief data handle migrating a PersistentContainer in SPGrid::loadBalance
+   *
+   * The container is resized to the new grid (by SPGrid::loadBalance calling
+   * resize) before the first value is scattered.
+   *
+   * \note The value type must be trivially copyable.
+   */
+  template< class Grid, class T >
+  class SPPersistentContainerDataHandle
+    : public CommDataHandleIF< SPPersistentContainerDataHandle< Grid, T >, T >
+  {
+  public:
+    typedef PersistentContainer< Grid, T > Container;
+
+    explicit SPPersistentContainerDataHandle ( Container &container ) : container_( container ) {}
+
+    bool contains ( int dim, int codim ) const { return (codim == container_.codimension()); }
+
+    bool fixedSize ( int dim, int codim ) const { return true; }
+
+    template< class Entity >
+    std::size_t size ( const Entity &entity ) const { return 1; }
+
+    template< class Buffer, class Entity >
+    void gather ( Buffer &buffer, const Entity &entity ) const
+    {
+      buffer.write( container_[ entity ] );
+    }
+
+    template< class Buffer, class Entity >
+    void scatter ( Buffer &buffer, const Entity &entity, std::size_t n )
+    {
+      buffer.read( container_[ entity ] );
+    }
+
+    /** \brief adapt the container to the redistributed grid */
+    void resize () { container_.resize(); }
+
+  private:
+    Container &container_;
+  };
+
 } // namespace Dune
 
 #endif // #ifndef DUNE_SPGRID_PERSISTENTCONTAINER_HH
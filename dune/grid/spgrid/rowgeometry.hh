@@ -0,0 +1,106 @@
+#ifndef DUNE_SPGRID_ROWGEOMETRY_HH
+#define DUNE_SPGRID_ROWGEOMETRY_HH
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+#include <dune/grid/spgrid/direction.hh>
+#include <dune/grid/spgrid/geometrycache.hh>
+#include <dune/grid/spgrid/gridlevel.hh>
+#include <dune/grid/spgrid/referencecube.hh>
+
+namespace Dune
+{
+
+  // SPRowGeometry
+  // -------------
+
+  /**
+   * \brief geometry of whole rows of entities
+   *
+   * A row consists of the count entities id, id + 2 e_0, ... (see
+   * forEachRow). As the grid is Cartesian, the images of a local coordinate
+   * form an arithmetic progression along the first axis and are constant
+   * along all other axes. The methods of this class write them into
+   * separate coordinate arrays (structure of arrays), using only the mesh
+   * width and the geometry cache of the grid level. The loops are simple
+   * enough for the compiler to vectorize.
+   */
+  template< int codim, class Grid >
+  class SPRowGeometry
+  {
+    typedef SPRowGeometry< codim, Grid > This;
+
+  public:
+    typedef SPGridLevel< typename std::remove_const< Grid >::type > GridLevel;
+
+    typedef typename GridLevel::ctype ctype;
+
+    static const int dimension = GridLevel::dimension;
+    static const int codimension = codim;
+    static const int mydimension = dimension - codimension;
+
+    typedef SPReferenceCube< ctype, mydimension > ReferenceCube;
+    typedef SPGeometryCache< ctype, dimension, codimension > GeometryCache;
+
+    typedef typename GeometryCache::GlobalVector GlobalVector;
+    typedef typename GeometryCache::LocalVector LocalVector;
+
+    typedef typename GridLevel::MultiIndex MultiIndex;
+
+    /** \brief one array per coordinate, each holding (at least) count values */
+    typedef std::array< ctype *, dimension > Coordinates;
+
+    explicit SPRowGeometry ( const GridLevel &gridLevel ) : gridLevel_( &gridLevel ) {}
+
+    /** \brief evaluate the geometry of each entity in a row in the same local coordinate */
+    void global ( const MultiIndex &id, int count, const LocalVector &local, const Coordinates &x ) const;
+
+    void corners ( const MultiIndex &id, int count, int i, const Coordinates &x ) const { global( id, count, ReferenceCube::corner( i ), x ); }
+    void centers ( const MultiIndex &id, int count, const Coordinates &x ) const { global( id, count, ReferenceCube::center(), x ); }
+
+    /** \brief volume shared by all entities in the row */
+    ctype volume ( const MultiIndex &id ) const { return geometryCache( id ).volume(); }
+
+    const GeometryCache &geometryCache ( const MultiIndex &id ) const
+    {
+      return gridLevel().template geometryCache< codimension >( SPDirection< dimension >( id ) );
+    }
+
+    const GridLevel &gridLevel () const { return *gridLevel_; }
+
+  private:
+    const GridLevel *gridLevel_;
+  };
+
+
+
+  // Implementation of SPRowGeometry
+  // -------------------------------
+
+  template< int codim, class Grid >
+  inline void SPRowGeometry< codim, Grid >
+    ::global ( const MultiIndex &id, int count, const LocalVector &local, const Coordinates &x ) const
+  {
+    const GlobalVector &h = gridLevel().h();
+
+    // image of local in the first entity (cf. SPGeometry)
+    GlobalVector y = gridLevel().domain().cube().origin();
+    for( int i = 0; i < dimension; ++i )
+      y[ i ] += (id[ i ] / 2) * h[ i ];
+    geometryCache( id ).jacobianTransposed().umtv( local, y );
+
+    const ctype y0 = y[ 0 ];
+    const ctype h0 = h[ 0 ];
+    ctype *const x0 = x[ 0 ];
+    for( int k = 0; k < count; ++k )
+      x0[ k ] = y0 + ctype( k ) * h0;
+
+    for( int i = 1; i < dimension; ++i )
+      std::fill( x[ i ], x[ i ] + count, y[ i ] );
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_ROWGEOMETRY_HH
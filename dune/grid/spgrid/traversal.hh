@@ -0,0 +1,155 @@
+#ifndef DUNE_SPGRID_TRAVERSAL_HH
+#define DUNE_SPGRID_TRAVERSAL_HH
+
+#include <cassert>
+
+#include <dune/grid/spgrid/multiindex.hh>
+
+namespace Dune
+{
+
+  // SPTraversal
+  // -----------
+
+  /**
+   * \brief order in which SPPartitionIterator visits the entities of a partition
+   *
+   * By default, entities are visited lexicographically with the first axis
+   * running fastest. Each bit of the sweep direction reverses the
+   * corresponding axis.
+   *
+   * A tiled traversal visits the entities tile by tile, each tile being
+   * traversed lexicographically. The tile extends over tile( i ) entities
+   * along axis i; a tile size of zero disables tiling along this axis.
+   * In serpentine order, an axis reverses its direction whenever the next
+   * axis advances (within each tile), so consecutive entities are always
+   * neighbors.
+   *
+   * A Morton traversal visits the entities along the Morton (Z-order)
+   * curve, i.e., in the order of an index set using SPMortonOrdering.
+   *
+   * A colored traversal only visits the entities of a single color, each
+   * color class being traversed lexicographically. The color is derived
+   * from the global position of the entity, so it is the same on all ranks.
+   * In the red-black coloring, entities sharing a face (resp. vertices
+   * sharing an edge) have different colors. In the coloring with 2^dim
+   * colors, entities sharing any subentity (resp. vertices sharing any
+   * element) have different colors. Hence, a Gauss-Seidel smoother may
+   * update all entities of one color in parallel; communicating after each
+   * color reproduces the serial result of the colored sweep.
+   *
+   * \note Colorings are not consistent across a periodic boundary with an
+   *       odd number of cells.
+   *
+   * \note Traversals are implicitly constructible from a sweep direction,
+   *       so they can be passed wherever a sweep direction was expected.
+   */
+  template< int dim >
+  class SPTraversal
+  {
+    typedef SPTraversal< dim > This;
+
+  public:
+    static const int dimension = dim;
+
+    typedef SPMultiIndex< dimension > MultiIndex;
+
+    SPTraversal ( unsigned int sweepDir = 0 )
+      : sweepDirection_( sweepDir ), tile_( MultiIndex::zero() ), serpentine_( false ), morton_( false )
+    {}
+
+    SPTraversal ( unsigned int sweepDir, const MultiIndex &tile, bool serpentine = false )
+      : sweepDirection_( sweepDir ), tile_( tile ), serpentine_( serpentine ), morton_( false )
+    {
+      for( int i = 0; i < dimension; ++i )
+        assert( tile_[ i ] >= 0 );
+    }
+
+    /** \brief tiled traversal in default sweep direction */
+    static This tiled ( const MultiIndex &tile, bool serpentine = false ) { return This( 0u, tile, serpentine ); }
+
+    /** \brief untiled traversal in serpentine order */
+    static This serpentine ( unsigned int sweepDir = 0 ) { return This( sweepDir, MultiIndex::zero(), true ); }
+
+    /** \brief traversal of one color (0 or 1) of a red-black coloring */
+    static This redBlack ( unsigned int color, unsigned int sweepDir = 0 ) { return colored( 2u, color, sweepDir ); }
+
+    /** \brief traversal of one color (0, ..., 2^dim-1) of a coloring with 2^dim colors */
+    static This multicolor ( unsigned int color, unsigned int sweepDir = 0 ) { return colored( 1u << dimension, color, sweepDir ); }
+
+    /** \brief traversal along the Morton curve */
+    static This morton ( unsigned int sweepDir = 0 )
+    {
+      This traversal( sweepDir );
+      traversal.morton_ = true;
+      return traversal;
+    }
+
+    unsigned int sweepDirection () const { return sweepDirection_; }
+    unsigned int sweepDirection ( int i ) const { return (sweepDirection_ >> i) & 1; }
+
+    const MultiIndex &tile () const { return tile_; }
+    int tile ( int i ) const { return tile_[ i ]; }
+
+    bool isTiled () const { return (tile_ != MultiIndex::zero()); }
+    bool isSerpentine () const { return serpentine_; }
+    bool isMorton () const { return morton_; }
+
+    /** \brief number of colors (1 if the traversal is not colored) */
+    unsigned int numColors () const { return numColors_; }
+
+    /** \brief color visited by this traversal */
+    unsigned int color () const { return color_; }
+
+    /** \brief color of the entity with given id */
+    unsigned int color ( const MultiIndex &id ) const;
+
+    bool isColored () const { return (numColors_ > 1); }
+
+    /** \brief does this traversal coincide with a plain lexicographic sweep? */
+    bool isLexicographic () const { return !isTiled() && !isSerpentine() && !isMorton() && !isColored(); }
+
+  private:
+    static This colored ( unsigned int numColors, unsigned int color, unsigned int sweepDir )
+    {
+      assert( color < numColors );
+      This traversal( sweepDir );
+      traversal.numColors_ = numColors;
+      traversal.color_ = color;
+      return traversal;
+    }
+
+    unsigned int sweepDirection_;
+    MultiIndex tile_;
+    bool serpentine_;
+    bool morton_;
+    unsigned int numColors_ = 1;
+    unsigned int color_ = 0;
+  };
+
+
+
+  // Implementation of SPTraversal
+  // -----------------------------
+
+  template< int dim >
+  inline unsigned int SPTraversal< dim >::color ( const MultiIndex &id ) const
+  {
+    // note: id >> 1 is the position of the entity along each axis
+    unsigned int color = 0;
+    if( numColors_ == 2u )
+    {
+      for( int i = 0; i < dimension; ++i )
+        color ^= (id[ i ] >> 1) & 1;
+    }
+    else if( numColors_ > 2u )
+    {
+      for( int i = 0; i < dimension; ++i )
+        color |= ((id[ i ] >> 1) & 1) << i;
+    }
+    return color;
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_TRAVERSAL_HH
@@ -0,0 +1,154 @@
+#ifndef DUNE_SPGRID_WAVEFRONT_HH
+#define DUNE_SPGRID_WAVEFRONT_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/gridview.hh>
+
+#include <dune/grid/spgrid/entityrange.hh>
+#include <dune/grid/spgrid/foreachindex.hh>
+#include <dune/grid/spgrid/partitionlist.hh>
+
+namespace Dune
+{
+
+  // SPWavefront
+  // -----------
+
+  /**
+   * \brief decomposition of a partition list into hyperplanes
+   *
+   * Hyperplane k contains the entities whose positions (along the sweep
+   * direction) sum up to k, i.e., for a sweep in positive directions, the
+   * elements with i + j + k = const in 3D. An element only shares faces
+   * with elements in the preceding or following hyperplane. So an upwind
+   * sweep can process the hyperplanes one after another, while all entities
+   * within a hyperplane can be processed in parallel.
+   *
+   * The hyperplanes are numbered by the global position of the entities, so
+   * they are well-defined across multiple partitions.
+   */
+  template< int codim, class Grid >
+  class SPWavefront
+  {
+    typedef SPWavefront< codim, Grid > This;
+
+  public:
+    typedef SPEntityRange< codim, Grid > Range;
+
+    static const int dimension = Range::dimension;
+    static const int codimension = codim;
+
+    typedef typename Range::GridLevel GridLevel;
+    typedef typename Range::MultiIndex MultiIndex;
+    typedef typename Range::PartitionList PartitionList;
+
+    SPWavefront ( const GridLevel &gridLevel, const PartitionList &partitionList, unsigned int sweepDir = 0, std::size_t grainSize = 1 );
+
+    /** \brief number of hyperplanes */
+    int size () const { return std::max( last_ - first_ + 1, 0 ); }
+
+    /** \brief entities in the k-th hyperplane (as splittable range) */
+    Range plane ( int k ) const;
+
+    /** \brief number of the hyperplane containing an entity */
+    int plane ( const MultiIndex &id ) const { return key( id ) - first_; }
+
+    const GridLevel &gridLevel () const { return *gridLevel_; }
+
+    unsigned int sweepDirection () const { return sweepDirection_; }
+
+  private:
+    int sign ( int i ) const { return 1 - 2*int( (sweepDirection_ >> i) & 1 ); }
+
+    int key ( const MultiIndex &id ) const;
+
+    const GridLevel *gridLevel_;
+    const PartitionList *partitionList_;
+    unsigned int sweepDirection_;
+    std::size_t grainSize_;
+    int first_, last_;
+  };
+
+
+
+  // Implementation of SPWavefront
+  // -----------------------------
+
+  template< int codim, class Grid >
+  inline SPWavefront< codim, Grid >
+    ::SPWavefront ( const GridLevel &gridLevel, const PartitionList &partitionList, unsigned int sweepDir, std::size_t grainSize )
+    : gridLevel_( &gridLevel ),
+      partitionList_( &partitionList ),
+      sweepDirection_( sweepDir ),
+      grainSize_( grainSize ),
+      first_( std::numeric_limits< int >::max() ),
+      last_( std::numeric_limits< int >::min() )
+  {
+    __SPGrid::forEachRow< codim >( partitionList, [ this ] ( unsigned int, const MultiIndex &id, int count ) {
+        MultiIndex last = id;
+        last[ 0 ] += 2*(count-1);
+        first_ = std::min( first_, std::min( key( id ), key( last ) ) );
+        last_ = std::max( last_, std::max( key( id ), key( last ) ) );
+      } );
+  }
+
+
+  template< int codim, class Grid >
+  inline typename SPWavefront< codim, Grid >::Range SPWavefront< codim, Grid >::plane ( int k ) const
+  {
+    assert( (k >= 0) && (k < size()) );
+
+    // each row along the first axis intersects the hyperplane in at most one entity
+    Range range( gridLevel(), grainSize_ );
+    __SPGrid::forEachRow< codim >( *partitionList_, [ this, &range, k ] ( unsigned int number, const MultiIndex &row, int count ) {
+        MultiIndex id = row;
+        const int shift = (first_ + k - key( row )) * sign( 0 );
+        id[ 0 ] += 2*shift;
+        if( (shift >= 0) && (shift < count) )
+          range.add( number, id, id );
+      } );
+    return range;
+  }
+
+
+  template< int codim, class Grid >
+  inline int SPWavefront< codim, Grid >::key ( const MultiIndex &id ) const
+  {
+    int key = 0;
+    for( int i = 0; i < dimension; ++i )
+      key += sign( i ) * (id[ i ] >> 1);
+    return key;
+  }
+
+
+
+  // wavefront
+  // ---------
+
+  /**
+   * \brief hyperplanes of the entities of a grid view
+   *
+   * \code
+   * const auto wavefront = Dune::wavefront< 0, Interior_Partition >( gridView, sweepDir );
+   * for( int k = 0; k < wavefront.size(); ++k )
+   *   tbb::parallel_for( wavefront.plane( k ), [] ( const auto &range ) { ... } );
+   * \endcode
+   */
+  template< int codim, PartitionIteratorType pitype = All_Partition, class ViewTraits >
+  inline SPWavefront< codim, const typename ViewTraits::Grid >
+  wavefront ( const GridView< ViewTraits > &gridView, unsigned int sweepDir = 0, std::size_t grainSize = 1 )
+  {
+    const auto &gridLevel = gridView.impl().gridLevel();
+    return SPWavefront< codim, const typename ViewTraits::Grid >( gridLevel, gridLevel.template partition< pitype >(), sweepDir, grainSize );
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_SPGRID_WAVEFRONT_HH
@@ -1,7 +1,11 @@
 #include <config.h>
 
+#include <cmath>
+#include <iterator>
 #include <limits>
+#include <numeric>
 #include <sstream>
+#include <vector>
 
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/iostream.hh>
@@ -118,13 +122,371 @@ void listLinkage ( const SPDecomposition< dimGrid > &decomposition, const MultiI
 }
 
 
+// forEachCell
+// -----------
+
+template< class F >
+void forEachCell ( const SPMesh< dimGrid > &mesh, F f )
+{
+  MultiIndex id = mesh.begin();
+  for( int d = 0; d < dimGrid; )
+  {
+    f( id );
+    for( d = 0; d < dimGrid; ++d )
+    {
+      if( ++id[ d ] < mesh.end()[ d ] )
+        break;
+      id[ d ] = mesh.begin()[ d ];
+    }
+  }
+}
+
+
+
+// checkSubMeshes
+// --------------
+
+void checkSubMeshes ( const SPDecomposition< dimGrid > &decomposition )
+{
+  typedef SPMesh< dimGrid > Mesh;
+
+  const Mesh &mesh = decomposition.mesh();
+  const std::vector< Mesh > subMeshes = decomposition.subMeshes();
+  if( subMeshes.size() != decomposition.size() )
+    DUNE_THROW( GridError, "Decomposition returns " << subMeshes.size() << " sub-meshes for " << decomposition.size() << " ranks." );
+
+  long volume = 0;
+  for( unsigned int rank = 0; rank < decomposition.size(); ++rank )
+  {
+    const Mesh &subMesh = decomposition.subMesh( rank );
+    if( !(subMesh.begin() == subMeshes[ rank ].begin()) || !(subMesh.end() == subMeshes[ rank ].end()) )
+      DUNE_THROW( GridError, "subMeshes() and subMesh( " << rank << " ) differ." );
+    if( subMesh.empty() || (subMesh.volume() <= 0) )
+      DUNE_THROW( GridError, "Sub-mesh of rank " << rank << " is empty." );
+    if( subMesh.intersect( mesh ).volume() != subMesh.volume() )
+      DUNE_THROW( GridError, "Sub-mesh of rank " << rank << " exceeds the mesh." );
+
+    for( unsigned int other = 0; other < rank; ++other )
+    {
+      const Mesh intersection = subMesh.intersect( decomposition.subMesh( other ) );
+      if( !intersection.empty() && (intersection.volume() > 0) )
+        DUNE_THROW( GridError, "Sub-meshes of ranks " << other << " and " << rank << " overlap." );
+    }
+
+    volume += subMesh.volume();
+  }
+
+  if( volume != mesh.volume() )
+    DUNE_THROW( GridError, "Sub-meshes do not cover the mesh (volume " << volume << " instead of " << mesh.volume() << ")." );
+}
+
+
+
+// checkWeightedDecomposition
+// --------------------------
+
+void checkWeightedDecomposition ()
+{
+  // a mesh stretched along the first axis, so all splits are orthogonal to it
+  MultiIndex width;
+  for( int i = 0; i < dimGrid; ++i )
+    width[ i ] = (i == 0 ? 12 : 2);
+  const SPMesh< dimGrid > mesh( width );
+
+  // cells get heavier along the first axis
+  const SPDecomposition< dimGrid >::Weight weight = [] ( const MultiIndex &id ) { return double( 1 + id[ 0 ] ); };
+  std::vector< double > weights;
+  weights.reserve( mesh.volume() );
+  forEachCell( mesh, [ &weight, &weights ] ( const MultiIndex &id ) { weights.push_back( weight( id ) ); } );
+  const double total = std::accumulate( weights.begin(), weights.end(), 0.0 );
+
+  // each split may miss its target by at most one slice per level of the bisection
+  const double slice = double( width[ 0 ] ) * double( mesh.volume() / width[ 0 ] );
+
+  for( unsigned int size = 1; size <= 5; ++size )
+  {
+    const SPDecomposition< dimGrid > decomposition( width, size, weights );
+    checkSubMeshes( decomposition );
+
+    if( !(decomposition == SPDecomposition< dimGrid >( width, size, weight )) )
+      DUNE_THROW( GridError, "Weighted decompositions from weight vector and callback differ." );
+
+    int levels = 0;
+    while( (1u << levels) < size )
+      ++levels;
+
+    const double target = total / double( size );
+    for( unsigned int rank = 0; rank < size; ++rank )
+    {
+      const SPMesh< dimGrid > &subMesh = decomposition.subMesh( rank );
+      double sum = 0.0;
+      forEachCell( subMesh, [ &weight, &sum ] ( const MultiIndex &id ) { sum += weight( id ); } );
+
+      if( std::abs( sum - target ) > levels * slice )
+        DUNE_THROW( GridError, "Weight of rank " << rank << " is " << sum << ", target is " << target << " (size " << size << ")." );
+    }
+  }
+
+  // invalid weight vectors have to be rejected
+  std::vector< std::vector< double > > invalid( 3, weights );
+  invalid[ 0 ].pop_back();
+  invalid[ 1 ][ 1 ] = -1.0;
+  invalid[ 2 ][ 2 ] = std::numeric_limits< double >::quiet_NaN();
+  for( const std::vector< double > &w : invalid )
+  {
+    bool thrown = false;
+    try
+    {
+      SPDecomposition< dimGrid > decomposition( width, 2u, w );
+    }
+    catch( const GridError & )
+    {
+      thrown = true;
+    }
+    if( !thrown )
+      DUNE_THROW( GridError, "Invalid weight vector accepted." );
+  }
+}
+
+
+
+// checkProcessorGrid
+// ------------------
+
+double interfaceArea ( const MultiIndex &width, const MultiIndex &layout )
+{
+  double area = 0.0;
+  for( int j = 0; j < dimGrid; ++j )
+  {
+    double face = double( layout[ j ] - 1 );
+    for( int k = 0; k < dimGrid; ++k )
+      face *= (k != j ? double( width[ k ] ) : 1.0);
+    area += face;
+  }
+  return area;
+}
+
+
+void checkProcessorGrid ( const MultiIndex &width, const unsigned int size, const MultiIndex &layout )
+{
+  // find the minimal interface area by brute force
+  double minArea = std::numeric_limits< double >::infinity();
+  MultiIndex current;
+  for( int i = 0; i < dimGrid; ++i )
+    current[ i ] = (layout[ i ] > 0 ? layout[ i ] : 1);
+  for( int d = 0; d < dimGrid; )
+  {
+    unsigned int product = 1;
+    bool fits = true;
+    for( int i = 0; i < dimGrid; ++i )
+    {
+      product *= current[ i ];
+      fits &= (current[ i ] <= width[ i ]);
+    }
+    if( fits && (product == size) )
+      minArea = std::min( minArea, interfaceArea( width, current ) );
+
+    for( d = 0; d < dimGrid; ++d )
+    {
+      if( (layout[ d ] == 0) && (++current[ d ] <= std::min( width[ d ], int( size ) )) )
+        break;
+      current[ d ] = (layout[ d ] > 0 ? layout[ d ] : 1);
+    }
+  }
+
+  MultiIndex grid;
+  try
+  {
+    grid = SPDecomposition< dimGrid >::processorGrid( width, size, layout );
+  }
+  catch( const GridError & )
+  {
+    if( minArea < std::numeric_limits< double >::infinity() )
+      throw;
+    return;
+  }
+  if( minArea == std::numeric_limits< double >::infinity() )
+    DUNE_THROW( GridError, "Processor grid " << grid << " returned for impossible layout " << layout << " on " << size << " ranks." );
+
+  unsigned int product = 1;
+  for( int i = 0; i < dimGrid; ++i )
+  {
+    if( (layout[ i ] > 0) && (grid[ i ] != layout[ i ]) )
+      DUNE_THROW( GridError, "Processor grid " << grid << " does not honor layout " << layout << "." );
+    if( (grid[ i ] < 1) || (grid[ i ] > width[ i ]) )
+      DUNE_THROW( GridError, "Invalid processor grid " << grid << " for width " << width << "." );
+    product *= grid[ i ];
+  }
+  if( product != size )
+    DUNE_THROW( GridError, "Processor grid " << grid << " does not match " << size << " ranks." );
+  if( interfaceArea( width, grid ) != minArea )
+    DUNE_THROW( GridError, "Processor grid " << grid << " has interface area " << interfaceArea( width, grid ) << ", minimum is " << minArea << "." );
+
+  // ranks are numbered lexicographically, the first axis running fastest
+  const SPDecomposition< dimGrid > decomposition( width, size, layout );
+  checkSubMeshes( decomposition );
+  for( unsigned int rank = 0; rank < size; ++rank )
+  {
+    const SPMesh< dimGrid > &subMesh = decomposition.subMesh( rank );
+    unsigned int block = rank;
+    for( int i = 0; i < dimGrid; ++i )
+    {
+      const int k = block % grid[ i ];
+      block /= grid[ i ];
+      if( (subMesh.begin()[ i ] != k*width[ i ] / grid[ i ]) || (subMesh.end()[ i ] != (k+1)*width[ i ] / grid[ i ]) )
+        DUNE_THROW( GridError, "Sub-mesh " << subMesh.begin() << " - " << subMesh.end() << " of rank " << rank
+                               << " does not match block " << k << " along axis " << i << " of processor grid " << grid << "." );
+    }
+  }
+}
+
+
+void checkProcessorGrid ()
+{
+  MultiIndex width;
+  for( int i = 0; i < dimGrid; ++i )
+    width[ i ] = 2 + 3*i;
+
+  for( unsigned int size = 1; size <= 12; ++size )
+  {
+    MultiIndex layout = MultiIndex::zero();
+    checkProcessorGrid( width, size, layout );
+
+    // keep the last axis undecomposed
+    layout[ dimGrid-1 ] = 1;
+    checkProcessorGrid( width, size, layout );
+
+    // pin the first axis (possibly to an impossible value)
+    layout = MultiIndex::zero();
+    layout[ 0 ] = 2;
+    checkProcessorGrid( width, size, layout );
+  }
+}
+
+
+
+// checkNodeDecomposition
+// ----------------------
+
+void checkNodeDecomposition ( const MultiIndex &width, const std::vector< int > &node )
+{
+  const unsigned int size = node.size();
+
+  const SPDecomposition< dimGrid > decomposition( width, node );
+  checkSubMeshes( decomposition );
+
+  for( unsigned int rank = 0; rank < size; ++rank )
+  {
+    if( (decomposition.block( rank ) >= size) || (decomposition.rank( decomposition.block( rank ) ) != rank) )
+      DUNE_THROW( GridError, "Block " << decomposition.block( rank ) << " of rank " << rank << " is not assigned to it." );
+  }
+
+  // the ranks of each node get adjacent blocks, forming a box
+  for( int k = 0; k < int( size ); ++k )
+  {
+    unsigned int count = 0, minBlock = size, maxBlock = 0;
+    long volume = 0;
+    MultiIndex begin = width, end = MultiIndex::zero();
+    for( unsigned int rank = 0; rank < size; ++rank )
+    {
+      if( node[ rank ] != k )
+        continue;
+      ++count;
+      minBlock = std::min( minBlock, decomposition.block( rank ) );
+      maxBlock = std::max( maxBlock, decomposition.block( rank ) );
+
+      const SPMesh< dimGrid > &subMesh = decomposition.subMesh( rank );
+      volume += subMesh.volume();
+      begin = std::min( begin, subMesh.begin() );
+      end = std::max( end, subMesh.end() );
+    }
+    if( count == 0 )
+      continue;
+
+    if( maxBlock - minBlock + 1 != count )
+      DUNE_THROW( GridError, "Blocks " << minBlock << " - " << maxBlock << " of node " << k << " are not adjacent." );
+    if( SPMesh< dimGrid >( begin, end ).volume() != volume )
+      DUNE_THROW( GridError, "Sub-meshes of node " << k << " do not form a box." );
+  }
+
+  // without reordering, blocks are assigned in order
+  const SPDecomposition< dimGrid > ordered( width, node, false );
+  checkSubMeshes( ordered );
+  for( unsigned int rank = 0; rank < size; ++rank )
+  {
+    if( (ordered.block( rank ) != rank) || (ordered.rank( rank ) != rank) )
+      DUNE_THROW( GridError, "Decomposition without reordering assigns block " << ordered.block( rank ) << " to rank " << rank << "." );
+  }
+}
+
+
+void checkNodeDecomposition ()
+{
+  MultiIndex width;
+  for( int i = 0; i < dimGrid; ++i )
+    width[ i ] = (i == 0 ? 16 : 2);
+
+  // round-robin placement of ranks onto two nodes
+  checkNodeDecomposition( width, { 0, 1, 0, 1, 0, 1, 0, 1 } );
+  // unevenly populated nodes with unused node indices
+  checkNodeDecomposition( width, { 3, 3, 0, 5, 0, 3, 5, 5, 3 } );
+  checkNodeDecomposition( width, { 2, 0, 0, 0, 2, 1, 0 } );
+  // a single node
+  checkNodeDecomposition( width, { 0, 0, 0 } );
+}
+
+
+
+// checkGridDecomposition
+// ----------------------
+
+template< class Grid >
+void checkGridDecomposition ( const SPDecomposition< dimGrid > &decomposition, const Grid &grid )
+{
+  if( !(grid.decomposition() == decomposition) )
+    DUNE_THROW( GridError, "Grid does not use the given decomposition." );
+
+  const SPMesh< dimGrid > &localMesh = grid.leafGridView().impl().gridLevel().localMesh();
+  const SPMesh< dimGrid > &subMesh = decomposition.subMesh( grid.comm().rank() );
+  if( !(localMesh.begin() == subMesh.begin()) || !(localMesh.end() == subMesh.end()) )
+    DUNE_THROW( GridError, "Local mesh " << localMesh.begin() << " - " << localMesh.end()
+                           << " differs from sub-mesh " << subMesh.begin() << " - " << subMesh.end() << "." );
+
+  const auto interiorElements = elements( grid.leafGridView(), Partitions::interior );
+  const long interior = std::distance( interiorElements.begin(), interiorElements.end() );
+  if( interior != subMesh.volume() )
+    DUNE_THROW( GridError, "Grid has " << interior << " interior elements, sub-mesh has " << subMesh.volume() << " cells." );
+}
+
+
+
 int main ( int argc, char **argv )
 {
-  Dune::MPIHelper::instance( argc, argv );
+  Dune::MPIHelper &mpiHelper = Dune::MPIHelper::instance( argc, argv );
+
+  typedef SPGrid< double, dimGrid > Grid;
+  FieldVector< double, dimGrid > a( 0.0 ), b( 1.0 );
+  SPDomain< double, dimGrid > domain( a, b );
+
+  if( argc == 1 )
+  {
+    checkWeightedDecomposition();
+    checkProcessorGrid();
+    checkNodeDecomposition();
+
+    MultiIndex width;
+    for( int i = 0; i < dimGrid; ++i )
+      width[ i ] = (i == 0 ? 8 : 2);
+    const SPDecomposition< dimGrid >::Weight weight = [] ( const MultiIndex &id ) { return double( 1 + id[ 0 ]*id[ 0 ] ); };
+    const SPDecomposition< dimGrid > decomposition( width, mpiHelper.size(), weight );
+    Grid grid( domain, decomposition, MultiIndex::zero() );
+    checkGridDecomposition( decomposition, grid );
+    return 0;
+  }
 
   if( argc < 3 )
   {
-    std::cerr << "Usage: " << argv[ 0 ] << " <width> <size> [overlap] [periodic]" << std::endl;
+    std::cerr << "Usage: " << argv[ 0 ] << " [<width> <size> [overlap] [periodic]]" << std::endl;
     return 1;
   }
 
@@ -210,9 +572,6 @@ int main ( int argc, char **argv )
   std::cout << "----------------------" << std::endl;
   listLinkage< All_All_Interface >( decomposition, overlap, topology );
 
-  typedef SPGrid< double, dimGrid > Grid;
-  FieldVector< double, dimGrid > a( 0.0 ), b( 1.0 );
-  SPDomain< double, dimGrid > domain( a, b );
   Grid grid( domain, width );
 
   std::cout << "grid created." << std::endl;
@@ -4,7 +4,15 @@
 #error "DIMGRID not defined. Please compile with -DDIMGRID=n"
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <sstream>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/parallel/mpihelper.hh>
@@ -83,6 +91,706 @@ void checkHierarchicSearch ( const GridView &gridView )
 }
 
 
+template< class Grid >
+void checkMigrationLists ( const Grid &grid )
+{
+  typedef typename Grid::Decomposition Decomposition;
+  typedef typename Grid::GridLevel GridLevel;
+  typedef Dune::SPMigration< Grid, Dune::SPPersistentContainerDataHandle< Grid, int > > Migration;
+
+  // split the macro mesh of a serial grid into two blocks (only the local one is built)
+  if( (grid.comm().size() > 1) || (grid.minLevel() > 0) )
+    return;
+  const GridLevel &oldLevel = grid.gridLevel( 0 );
+  const Decomposition decomposition( grid.decomposition().mesh(), 2u );
+  if( decomposition.subMesh( 1 ).empty() )
+    return;
+  const GridLevel newLevel( grid, decomposition );
+
+  // a serial grid sends to both blocks exactly their All partitions
+  const std::vector< unsigned int > ranks = Migration::ranks( oldLevel, decomposition );
+  if( ranks != std::vector< unsigned int >{ 0u, 1u } )
+    DUNE_THROW( Dune::GridError, "Migration does not find the ranks of a split decomposition." );
+
+  const long remoteVolume = Migration::partitionPool( newLevel, 1 ).template get< Dune::All_Partition >().volume();
+  if( Migration::sendList( oldLevel, newLevel, 1 )->volume() != remoteVolume )
+    DUNE_THROW( Dune::GridError, "Migration sends wrong entities to the new rank." );
+
+  const long localVolume = newLevel.template partition< Dune::All_Partition >().volume();
+  if( (Migration::sendList( oldLevel, newLevel, 0 )->volume() != localVolume) || (Migration::receiveList( oldLevel, newLevel, 0 )->volume() != localVolume) )
+    DUNE_THROW( Dune::GridError, "Migration does not keep the local entities." );
+}
+
+
+template< int codim, class Grid >
+void checkMigratedIds ( const Grid &grid, const Dune::PersistentContainer< Grid, typename Grid::GlobalIdSet::IdType > &ids )
+{
+  for( int level = grid.minLevel(); level <= grid.maxLevel(); ++level )
+  {
+    for( const auto &entity : entities( grid.levelGridView( level ), Dune::Codim< codim >(), Dune::Partitions::all ) )
+    {
+      if( ids[ entity ] != grid.globalIdSet().id( entity ) )
+        DUNE_THROW( Dune::GridError, "Data (codimension " << codim << ") not migrated correctly by loadBalance." );
+    }
+  }
+}
+
+
+template< int codim, class Grid >
+void fillIds ( const Grid &grid, Dune::PersistentContainer< Grid, typename Grid::GlobalIdSet::IdType > &ids )
+{
+  ids.resize();
+  for( int level = grid.minLevel(); level <= grid.maxLevel(); ++level )
+  {
+    for( const auto &entity : entities( grid.levelGridView( level ), Dune::Codim< codim >(), Dune::Partitions::all ) )
+      ids[ entity ] = grid.globalIdSet().id( entity );
+  }
+}
+
+
+template< class Grid >
+void checkLoadBalance ( Grid &grid )
+{
+  typedef typename Grid::Decomposition Decomposition;
+  typedef typename Decomposition::MultiIndex MultiIndex;
+  typedef typename Grid::GlobalIdSet::IdType IdType;
+
+  std::cerr << ">>> Checking load balancing..." << std::endl;
+
+  checkMigrationLists( grid );
+
+  const Decomposition original = grid.decomposition();
+  const bool parallel = (grid.comm().size() > 1);
+
+  // shift the load towards the lower end of the first axis, migrating elements
+  Dune::PersistentContainer< Grid, IdType > elementIds( grid, 0 );
+  fillIds< 0 >( grid, elementIds );
+  const Decomposition decomposition( original.mesh(), grid.comm().size(), [] ( const MultiIndex &id ) { return 1.0 + id[ 0 ]; } );
+  Dune::SPPersistentContainerDataHandle< Grid, IdType > elementHandle( elementIds );
+  if( grid.loadBalance( decomposition, elementHandle ) != parallel )
+    DUNE_THROW( Dune::GridError, "loadBalance does not report the change of decomposition." );
+  checkMigratedIds< 0 >( grid, elementIds );
+
+  // restore the original decomposition, migrating vertices
+  Dune::PersistentContainer< Grid, IdType > vertexIds( grid, Grid::dimension );
+  fillIds< Grid::dimension >( grid, vertexIds );
+  Dune::SPPersistentContainerDataHandle< Grid, IdType > vertexHandle( vertexIds );
+  if( grid.loadBalance( original, vertexHandle ) != parallel )
+    DUNE_THROW( Dune::GridError, "loadBalance does not report the change of decomposition." );
+  checkMigratedIds< Grid::dimension >( grid, vertexIds );
+}
+
+
+template< int codim, class GridView >
+void checkTraversal ( const GridView &gridView, const Dune::SPTraversal< GridView::dimension > &traversal )
+{
+  std::vector< int > indices, expected;
+  const auto end = gridView.impl().template end< codim, Dune::All_Partition >( traversal );
+  for( auto it = gridView.impl().template begin< codim, Dune::All_Partition >( traversal ); it != end; ++it )
+    indices.push_back( gridView.indexSet().index( *it ) );
+  for( const auto &entity : entities( gridView, Dune::Codim< codim >(), Dune::Partitions::all ) )
+    expected.push_back( gridView.indexSet().index( entity ) );
+
+  std::sort( indices.begin(), indices.end() );
+  std::sort( expected.begin(), expected.end() );
+  if( indices != expected )
+    DUNE_THROW( Dune::GridError, "Traversal does not visit each entity exactly once." );
+}
+
+
+template< class Grid >
+void checkTraversals ( const Grid &grid )
+{
+  typedef typename Grid::Traversal Traversal;
+  typedef typename Traversal::MultiIndex MultiIndex;
+
+  std::cerr << ">>> Checking tiled traversals..." << std::endl;
+
+  MultiIndex tile;
+  for( int i = 0; i < Grid::dimension; ++i )
+    tile[ i ] = 2 + i;
+  const Traversal traversals[] = { Traversal::tiled( tile ), Traversal::tiled( tile, true ), Traversal::serpentine(), Traversal( Grid::numDirections-1, tile, true ) };
+  for( const Traversal &traversal : traversals )
+  {
+    Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &grid, &traversal ] ( auto codim ) {
+        checkTraversal< codim >( grid.leafGridView(), traversal );
+      } );
+  }
+}
+
+
+template< class Grid >
+void checkColoredTraversals ( const Grid &grid )
+{
+  typedef typename Grid::Traversal Traversal;
+
+  std::cerr << ">>> Checking colored traversals..." << std::endl;
+
+  // the color classes partition the entities, and face neighbors never share a color
+  // note: periodic neighbors are skipped, as colorings need not be periodic
+  const auto gridView = grid.leafGridView();
+  for( unsigned int numColors : { 2u, 1u << Grid::dimension } )
+  {
+    Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView, numColors ] ( auto codim ) {
+        std::vector< int > visited( gridView.indexSet().size( codim ), 0 );
+        for( unsigned int color = 0; color < numColors; ++color )
+        {
+          const Traversal traversal = (numColors == 2u ? Traversal::redBlack( color ) : Traversal::multicolor( color ));
+          const auto end = gridView.impl().template end< codim, Dune::All_Partition >( traversal );
+          for( auto it = gridView.impl().template begin< codim, Dune::All_Partition >( traversal ); it != end; ++it )
+          {
+            ++visited[ gridView.indexSet().index( *it ) ];
+            if( traversal.color( it->impl().entityInfo().id() ) != color )
+              DUNE_THROW( Dune::GridError, "Colored traversal visits entity of wrong color." );
+            if( codim != 0 )
+              continue;
+            for( const auto &intersection : intersections( gridView, *it ) )
+            {
+              if( intersection.neighbor() && !intersection.boundary() && (traversal.color( intersection.outside().impl().entityInfo().id() ) == color) )
+                DUNE_THROW( Dune::GridError, "Neighboring elements have the same color." );
+            }
+          }
+        }
+        if( std::any_of( visited.begin(), visited.end(), [] ( int v ) { return (v != 1); } ) )
+          DUNE_THROW( Dune::GridError, "Color classes do not partition the entities." );
+      } );
+  }
+}
+
+
+template< class Grid >
+void checkMortonOrdering ( const Grid &grid )
+{
+  std::cerr << ">>> Checking Morton ordering..." << std::endl;
+
+  // traversing along the Morton curve enumerates the Morton index set consecutively
+  const auto gridView = grid.template leafGridView< Dune::SPMortonOrdering >();
+  const auto traversal = Dune::SPTraversal< Grid::dimension >::morton();
+  Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView, &traversal ] ( auto codim ) {
+      std::size_t index = 0;
+      const auto end = gridView.impl().template end< codim, Dune::All_Partition >( traversal );
+      for( auto it = gridView.impl().template begin< codim, Dune::All_Partition >( traversal ); it != end; ++it, ++index )
+      {
+        if( gridView.indexSet().index( *it ) != index )
+          DUNE_THROW( Dune::GridError, "Morton traversal does not match Morton index set." );
+      }
+      if( index != gridView.indexSet().size( codim ) )
+        DUNE_THROW( Dune::GridError, "Morton traversal does not visit all entities." );
+    } );
+}
+
+
+template< class Grid >
+void checkOwnerFirstOrdering ( const Grid &grid )
+{
+  std::cerr << ">>> Checking owner-first ordering..." << std::endl;
+
+  // indices are a permutation, numbering interior before owned border entities before all
+  // other entities, which are grouped by owner
+  const auto gridView = grid.template leafGridView< Dune::SPOwnerFirstOrdering<> >();
+  const auto &gridLevel = gridView.impl().gridLevel();
+  const int localRank = grid.comm().rank();
+
+  // an entity is owned by the rank containing the cell above it (the last cell on the upper boundary)
+  const auto owner = [ &grid, &gridLevel ] ( const auto &id ) {
+      const auto &globalMesh = gridLevel.globalMesh();
+      for( int rank = 0; rank < grid.comm().size(); ++rank )
+      {
+        const auto subMesh = gridLevel.subMesh( rank );
+        bool contains = true;
+        for( int i = 0; i < Grid::dimension; ++i )
+        {
+          int c = id[ i ];
+          if( gridLevel.domain().topology().hasNeighbor( 0, 2*i ) && (c == 2*globalMesh.end()[ i ]) )
+            c = 2*globalMesh.begin()[ i ];
+          const int cell = std::min( c >> 1, globalMesh.end()[ i ]-1 );
+          contains &= (cell >= subMesh.begin()[ i ]) && (cell < subMesh.end()[ i ]);
+        }
+        if( contains )
+          return rank;
+      }
+      DUNE_THROW( Dune::GridError, "Entity not owned by any rank." );
+    };
+
+  checkSubIndex( gridView );
+  Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView, &owner, localRank ] ( auto codim ) {
+      std::vector< int > key( gridView.indexSet().size( codim ), -1 );
+      for( const auto &entity : entities( gridView, Dune::Codim< codim >() ) )
+      {
+        const auto index = gridView.indexSet().index( entity );
+        if( key[ index ] != -1 )
+          DUNE_THROW( Dune::GridError, "Owner-first index set assigns an index twice." );
+        const Dune::PartitionType type = entity.partitionType();
+        const int rank = owner( entity.impl().entityInfo().id() );
+        if( type == Dune::InteriorEntity )
+          key[ index ] = 0;
+        else if( (type == Dune::BorderEntity) && (rank == localRank) )
+          key[ index ] = 1;
+        else
+          key[ index ] = 2 + rank;
+      }
+      if( !std::is_sorted( key.begin(), key.end() ) || (!key.empty() && (key.front() < 0)) )
+        DUNE_THROW( Dune::GridError, "Owner-first index set does not group the entities by owner." );
+    } );
+}
+
+
+template< Dune::PartitionIteratorType pitype, class Grid >
+void checkPartitionIndexSet ( const Grid &grid )
+{
+  std::cerr << ">>> Checking index set for partition " << pitype << "..." << std::endl;
+
+  // the index set numbers exactly the entities of the partition consecutively
+  const auto gridView = grid.leafGridView();
+  const Dune::SPIndexSet< const Grid, Dune::SPLexicographicOrdering, pitype > indexSet( gridView.impl().gridLevel() );
+  Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView, &indexSet ] ( auto codim ) {
+      std::vector< bool > visited( indexSet.size( codim ), false );
+      std::size_t count = 0;
+      const auto end = gridView.impl().template end< codim, pitype >();
+      for( auto it = gridView.impl().template begin< codim, pitype >(); it != end; ++it, ++count )
+      {
+        if( !indexSet.contains( *it ) )
+          DUNE_THROW( Dune::GridError, "Partition index set does not contain entity of its partition." );
+        const auto index = indexSet.index( *it );
+        if( (index >= visited.size()) || visited[ index ] )
+          DUNE_THROW( Dune::GridError, "Partition index set assigns invalid or duplicate index." );
+        visited[ index ] = true;
+      }
+      if( count != visited.size() )
+        DUNE_THROW( Dune::GridError, "Partition index set has wrong size." );
+    } );
+}
+
+
+template< class GridView >
+void checkInverseIndex ( const GridView &gridView )
+{
+  // entity( index ) inverts index, for every codimension
+  const auto &indexSet = gridView.indexSet();
+  Dune::Hybrid::forEach( std::make_integer_sequence< int, GridView::dimension+1 >(), [ &indexSet ] ( auto codim ) {
+      for( std::size_t index = 0; index < indexSet.size( codim ); ++index )
+      {
+        const auto entity = indexSet.template entity< codim >( index );
+        if( indexSet.index( entity ) != index )
+          DUNE_THROW( Dune::GridError, "Index set does not invert index." );
+      }
+    } );
+}
+
+
+template< class Grid >
+void checkInverseIndex ( const Grid &grid )
+{
+  std::cerr << ">>> Checking inverse index mapping..." << std::endl;
+
+  checkInverseIndex( grid.leafGridView() );
+  checkInverseIndex( grid.template leafGridView< Dune::SPMortonOrdering >() );
+  checkInverseIndex( grid.template leafGridView< Dune::SPOwnerFirstOrdering<> >() );
+}
+
+
+template< class Grid >
+void checkDeepInterior ( const Grid &grid )
+{
+  std::cerr << ">>> Checking deep interior..." << std::endl;
+
+  // deep interior and shell partition the interior
+  const auto gridView = grid.leafGridView();
+  for( int width = 0; width <= 2; ++width )
+  {
+    const auto deepInterior = gridView.impl().deepInterior( width );
+    const auto shell = gridView.impl().shell( width );
+    Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView, &deepInterior, &shell, width ] ( auto codim ) {
+        std::vector< int > visited( gridView.indexSet().size( codim ), 0 );
+        const auto dend = gridView.impl().template end< codim >( deepInterior );
+        for( auto it = gridView.impl().template begin< codim >( deepInterior ); it != dend; ++it )
+        {
+          ++visited[ gridView.indexSet().index( *it ) ];
+          if( (codim != 0) || (width == 0) )
+            continue;
+          for( const auto &intersection : intersections( gridView, *it ) )
+          {
+            if( intersection.neighbor() && (intersection.outside().partitionType() != Dune::InteriorEntity) )
+              DUNE_THROW( Dune::GridError, "Deep interior element has non-interior neighbor." );
+          }
+        }
+        const auto send = gridView.impl().template end< codim >( shell );
+        for( auto it = gridView.impl().template begin< codim >( shell ); it != send; ++it )
+          ++visited[ gridView.indexSet().index( *it ) ];
+
+        for( const auto &entity : entities( gridView, Dune::Codim< codim >() ) )
+        {
+          const int expected = (entity.partitionType() == Dune::InteriorEntity ? 1 : 0);
+          if( visited[ gridView.indexSet().index( entity ) ] != expected )
+            DUNE_THROW( Dune::GridError, "Deep interior and shell do not partition the interior." );
+        }
+      } );
+  }
+}
+
+
+template< class Grid >
+void checkEntityRange ( const Grid &grid )
+{
+  std::cerr << ">>> Checking entity ranges..." << std::endl;
+
+  // the chunks of an entity range cover each entity exactly once
+  const auto gridView = grid.leafGridView();
+  Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView ] ( auto codim ) {
+      const auto range = Dune::entityRange< codim >( gridView, 4 );
+      if( range.size() != std::size_t( gridView.indexSet().size( codim ) ) )
+        DUNE_THROW( Dune::GridError, "Entity range has wrong size." );
+
+      std::vector< int > visited( range.size(), 0 );
+      std::size_t size = 0;
+      for( const auto &chunk : range.chunks( 7 ) )
+      {
+        size += chunk.size();
+        for( const auto &entity : chunk )
+          ++visited[ gridView.indexSet().index( entity ) ];
+      }
+      if( size != range.size() )
+        DUNE_THROW( Dune::GridError, "Chunks do not add up to the entity range." );
+      if( std::any_of( visited.begin(), visited.end(), [] ( int v ) { return (v != 1); } ) )
+        DUNE_THROW( Dune::GridError, "Chunks do not visit each entity exactly once." );
+    } );
+}
+
+
+template< class Grid >
+void checkWavefront ( const Grid &grid )
+{
+  std::cerr << ">>> Checking wavefronts..." << std::endl;
+
+  // hyperplanes partition the elements, and face neighbors lie in adjacent hyperplanes
+  const auto gridView = grid.leafGridView();
+  for( unsigned int sweepDir = 0; sweepDir < Grid::numDirections; ++sweepDir )
+  {
+    const auto wavefront = Dune::wavefront< 0 >( gridView, sweepDir );
+    std::vector< int > plane( gridView.indexSet().size( 0 ), -1 );
+    for( int k = 0; k < wavefront.size(); ++k )
+    {
+      for( const auto &element : wavefront.plane( k ) )
+      {
+        const auto index = gridView.indexSet().index( element );
+        if( plane[ index ] != -1 )
+          DUNE_THROW( Dune::GridError, "Element visited by multiple hyperplanes." );
+        plane[ index ] = k;
+      }
+    }
+
+    for( const auto &element : elements( gridView ) )
+    {
+      const int k = plane[ gridView.indexSet().index( element ) ];
+      if( k != wavefront.plane( element.impl().entityInfo().id() ) )
+        DUNE_THROW( Dune::GridError, "Element not visited by its hyperplane." );
+      for( const auto &intersection : intersections( gridView, element ) )
+      {
+        if( intersection.neighbor() && !intersection.boundary() && (std::abs( plane[ gridView.indexSet().index( intersection.outside() ) ] - k ) != 1) )
+          DUNE_THROW( Dune::GridError, "Face neighbors not in adjacent hyperplanes." );
+      }
+    }
+  }
+}
+
+
+template< class Grid >
+void checkForEachIndex ( const Grid &grid )
+{
+  std::cerr << ">>> Checking forEachIndex..." << std::endl;
+
+  // kernels see the same ids and indices as the partition iterator
+  const auto gridView = grid.leafGridView();
+  const Dune::SPIndexGeometry< Grid > geometry( gridView );
+  typedef typename Dune::SPIndexGeometry< Grid >::MultiIndex MultiIndex;
+  Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView, &geometry ] ( auto codim ) {
+      std::vector< std::pair< MultiIndex, std::size_t > > indices;
+      Dune::forEachIndex< codim >( gridView, [ &indices ] ( const MultiIndex &id, std::size_t index ) {
+          indices.emplace_back( id, index );
+        } );
+      if( indices.size() != std::size_t( gridView.indexSet().size( codim ) ) )
+        DUNE_THROW( Dune::GridError, "forEachIndex does not visit all entities." );
+
+      std::size_t k = 0;
+      for( const auto &entity : entities( gridView, Dune::Codim< codim >() ) )
+      {
+        if( (entity.impl().entityInfo().id() != indices[ k ].first) || (gridView.indexSet().index( entity ) != indices[ k ].second) )
+          DUNE_THROW( Dune::GridError, "forEachIndex does not match the partition iterator." );
+        if( (entity.geometry().center() - geometry.center( indices[ k ].first )).two_norm() > 1e-8 )
+          DUNE_THROW( Dune::GridError, "SPIndexGeometry returns wrong center." );
+        ++k;
+      }
+
+      std::size_t size = 0;
+      Dune::forEachRow< codim >( gridView, [ &indices, &size ] ( const MultiIndex &id, std::size_t index, int count ) {
+          if( (indices[ size ].first != id) || (indices[ size ].second != index) )
+            DUNE_THROW( Dune::GridError, "forEachRow does not match forEachIndex." );
+          size += count;
+        } );
+      if( size != indices.size() )
+        DUNE_THROW( Dune::GridError, "forEachRow does not visit all entities." );
+    } );
+}
+
+
+template< class Grid >
+void checkFaceRuns ( const Grid &grid )
+{
+  std::cerr << ">>> Checking face runs..." << std::endl;
+
+  // collect inside and outside elements of each face from the intersections
+  const auto gridView = grid.leafGridView();
+  const auto &indexSet = gridView.indexSet();
+  std::vector< int > insideOf( indexSet.size( 1 ), -1 ), outsideOf( indexSet.size( 1 ), -1 );
+  for( const auto &element : elements( gridView ) )
+  {
+    for( const auto &intersection : intersections( gridView, element ) )
+    {
+      const int face = indexSet.subIndex( element, intersection.indexInInside(), 1 );
+      const bool upper = (intersection.indexInInside() & 1);
+      (upper ? insideOf : outsideOf)[ face ] = indexSet.index( element );
+      if( intersection.neighbor() )
+        (upper ? outsideOf : insideOf)[ face ] = indexSet.index( intersection.outside() );
+    }
+  }
+
+  std::vector< int > visited( indexSet.size( 1 ), 0 );
+  Dune::forEachFaceRun( gridView, [ &insideOf, &outsideOf, &visited ] ( const auto &run ) {
+      for( int k = 0; k < run.count; ++k )
+      {
+        const auto face = run.face + k;
+        ++visited[ face ];
+        if( (run.hasInside ? int( run.inside + k ) : -1) != insideOf[ face ] )
+          DUNE_THROW( Dune::GridError, "Face run has wrong inside element." );
+        if( (run.hasOutside ? int( run.outside + k ) : -1) != outsideOf[ face ] )
+          DUNE_THROW( Dune::GridError, "Face run has wrong outside element." );
+      }
+    } );
+  if( std::any_of( visited.begin(), visited.end(), [] ( int v ) { return (v != 1); } ) )
+    DUNE_THROW( Dune::GridError, "Face runs do not visit each face exactly once." );
+}
+
+
+template< class Grid >
+void checkBoundaryRuns ( const Grid &grid )
+{
+  std::cerr << ">>> Checking boundary runs..." << std::endl;
+
+  // collect element and boundary segment of each boundary face from the intersections
+  const auto gridView = grid.leafGridView();
+  const auto &indexSet = gridView.indexSet();
+  std::vector< int > elementOf( indexSet.size( 1 ), -1 ), segmentOf( indexSet.size( 1 ), -1 );
+  for( const auto &element : elements( gridView ) )
+  {
+    for( const auto &intersection : intersections( gridView, element ) )
+    {
+      if( !intersection.boundary() )
+        continue;
+      const int face = indexSet.subIndex( element, intersection.indexInInside(), 1 );
+      elementOf[ face ] = indexSet.index( element );
+      segmentOf[ face ] = intersection.boundarySegmentIndex();
+    }
+  }
+
+  std::vector< int > visited( indexSet.size( 1 ), 0 );
+  Dune::forEachBoundaryRun( gridView, [ &elementOf, &segmentOf, &visited ] ( const auto &run ) {
+      for( int k = 0; k < run.count; ++k )
+      {
+        const auto face = run.face + k*run.faceStride;
+        ++visited[ face ];
+        if( int( run.element + k*run.elementStride ) != elementOf[ face ] )
+          DUNE_THROW( Dune::GridError, "Boundary run has wrong element." );
+        if( int( run.segment + ((run.segmentPhase + k) / run.segmentFactor)*run.segmentStride ) != segmentOf[ face ] )
+          DUNE_THROW( Dune::GridError, "Boundary run has wrong boundary segment index." );
+      }
+    } );
+  for( std::size_t face = 0; face < visited.size(); ++face )
+  {
+    if( visited[ face ] != (elementOf[ face ] >= 0 ? 1 : 0) )
+      DUNE_THROW( Dune::GridError, "Boundary runs do not visit each boundary face exactly once." );
+  }
+}
+
+
+template< class Grid >
+void checkRowGeometry ( const Grid &grid )
+{
+  std::cerr << ">>> Checking row geometry..." << std::endl;
+
+  const auto gridView = grid.leafGridView();
+  typedef typename Dune::SPIndexGeometry< Grid >::MultiIndex MultiIndex;
+  Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &gridView ] ( auto codim ) {
+      typedef Dune::SPRowGeometry< codim, const Grid > RowGeometry;
+
+      std::vector< typename RowGeometry::GlobalVector > centers( gridView.indexSet().size( codim ) );
+      for( const auto &entity : entities( gridView, Dune::Codim< codim >() ) )
+        centers[ gridView.indexSet().index( entity ) ] = entity.geometry().center();
+
+      const RowGeometry rowGeometry( gridView.impl().gridLevel() );
+      std::array< std::vector< typename RowGeometry::ctype >, Grid::dimension > x;
+      Dune::forEachRow< codim >( gridView, [ &centers, &rowGeometry, &x ] ( const MultiIndex &id, std::size_t index, int count ) {
+          typename RowGeometry::Coordinates coordinates;
+          for( int i = 0; i < Grid::dimension; ++i )
+          {
+            x[ i ].resize( count );
+            coordinates[ i ] = x[ i ].data();
+          }
+          rowGeometry.centers( id, count, coordinates );
+          for( int k = 0; k < count; ++k )
+          {
+            for( int i = 0; i < Grid::dimension; ++i )
+            {
+              if( std::abs( x[ i ][ k ] - centers[ index + k ][ i ] ) > 1e-8 )
+                DUNE_THROW( Dune::GridError, "SPRowGeometry returns wrong center." );
+            }
+          }
+        } );
+    } );
+}
+
+
+template< class Grid >
+void checkLocalIds ( const Grid &grid )
+{
+  std::cerr << ">>> Checking local ids..." << std::endl;
+
+  // two entities must share their id iff they are copies of the same entity
+  typedef typename Grid::LocalIdSet::IdType IdType;
+  typedef std::array< int, Grid::dimension+1 > Key;
+  std::map< IdType, Key > keyOf;
+  std::map< Key, IdType > idOf;
+  for( int level = grid.minLevel(); level <= grid.maxLevel(); ++level )
+  {
+    Dune::Hybrid::forEach( std::make_integer_sequence< int, Grid::dimension+1 >(), [ &grid, &keyOf, &idOf, level ] ( auto codim ) {
+        for( const auto &entity : entities( grid.levelGridView( level ), Dune::Codim< codim >() ) )
+        {
+          // reference: follow the fathers of copies
+          auto id = entity.impl().entityInfo().id();
+          int k = level;
+          while( (k > grid.minLevel()) && grid.gridLevel( k ).refinement().isCopy( id ) )
+            grid.gridLevel( k-- ).refinement().father( id );
+
+          Key key;
+          key[ 0 ] = k;
+          std::copy( id.begin(), id.end(), key.begin()+1 );
+          const IdType localId = grid.localIdSet().id( entity );
+          if( (keyOf.emplace( localId, key ).first->second != key) || (idOf.emplace( key, localId ).first->second != localId) )
+            DUNE_THROW( Dune::GridError, "Local ids do not identify copies with their fathers." );
+        }
+      } );
+  }
+}
+
+
+template< class Grid >
+void checkRefinedSubMeshes ( const Grid &grid )
+{
+  std::cerr << ">>> Checking sub-meshes on refined levels..." << std::endl;
+
+  const auto &decomposition = grid.decomposition();
+  auto equal = [] ( const auto &a, const auto &b ) { return (a.begin() == b.begin()) && (a.end() == b.end()); };
+
+  for( int level = grid.minLevel(); level <= grid.maxLevel(); ++level )
+  {
+    const auto &gridLevel = grid.levelGridView( level ).impl().gridLevel();
+    if( !equal( gridLevel.localMesh(), gridLevel.subMesh( grid.comm().rank() ) ) )
+      DUNE_THROW( Dune::GridError, "Local mesh differs from sub-mesh of own rank on level " << level << "." );
+
+    for( unsigned int rank = 0; rank < decomposition.size(); ++rank )
+    {
+      // the sub-mesh of each rank is the refined macro sub-mesh
+      const auto subMesh = gridLevel.subMesh( rank );
+      if( level == 0 )
+      {
+        if( !equal( subMesh, decomposition.subMesh( rank ) ) )
+          DUNE_THROW( Dune::GridError, "Sub-mesh of rank " << rank << " differs from macro sub-mesh." );
+      }
+      else if( level > grid.minLevel() )
+      {
+        const auto &father = grid.levelGridView( level-1 ).impl().gridLevel();
+        if( !equal( subMesh, father.subMesh( rank ).refine( gridLevel.refinement() ) ) )
+          DUNE_THROW( Dune::GridError, "Sub-mesh of rank " << rank << " on level " << level << " is not the refined sub-mesh of level " << (level-1) << "." );
+      }
+    }
+  }
+}
+
+
+template< class Grid >
+void checkDecompositionReport ( const Grid &grid )
+{
+  std::cerr << ">>> Checking decomposition report..." << std::endl;
+
+  const Dune::SPDecompositionReport< Grid > report( grid );
+  const auto interiorVolume = report.interiorVolumeStatistics();
+  if( interiorVolume.sum != grid.leafLevel().globalMesh().volume() )
+    DUNE_THROW( Dune::GridError, "Interior volumes do not sum up to the global volume." );
+  if( (interiorVolume.min > interiorVolume.average) || (interiorVolume.average > interiorVolume.max) )
+    DUNE_THROW( Dune::GridError, "Inconsistent statistics of interior volume." );
+
+  // interior cells are never shared
+  if( report.entities( Dune::InteriorBorder_InteriorBorder_Interface, 0 ) != 0 )
+    DUNE_THROW( Dune::GridError, "Cells sent through InteriorBorder_InteriorBorder_Interface." );
+
+  std::ostringstream out;
+  report.print( out );
+  if( out.str().empty() )
+    DUNE_THROW( Dune::GridError, "Empty decomposition report." );
+}
+
+
+template< class Grid >
+void checkDiscardLevels ( Grid &grid, const typename Grid::RefinementPolicy &policy )
+{
+  typedef typename Grid::LocalIdSet::IdType IdType;
+
+  std::cerr << ">>> Checking removal of grid levels..." << std::endl;
+
+  // grid views with a different ordering are updated with the grid
+  const auto mortonView = grid.template leafGridView< Dune::SPMortonOrdering >();
+  const auto checkMortonView = [ &grid, &mortonView ] () {
+      for( int codim = 0; codim <= Grid::dimension; ++codim )
+      {
+        if( mortonView.indexSet().size( codim ) != grid.leafIndexSet().size( codim ) )
+          DUNE_THROW( Dune::GridError, "Grid view with Morton ordering not updated on grid modification." );
+      }
+    };
+
+  const int maxLevel = grid.maxLevel();
+  grid.globalRefine( 1, policy );
+  checkMortonView();
+  grid.globalRefine( -1 );
+  if( grid.maxLevel() != maxLevel )
+    DUNE_THROW( Dune::GridError, "globalRefine( -1 ) did not remove the finest level." );
+  checkMortonView();
+
+  std::vector< IdType > ids;
+  for( const auto &element : elements( grid.leafGridView(), Dune::Partitions::all ) )
+    ids.push_back( grid.localIdSet().id( element ) );
+
+  grid.discardCoarseLevels( maxLevel );
+  if( (grid.minLevel() != maxLevel) || (grid.maxLevel() != maxLevel) )
+    DUNE_THROW( Dune::GridError, "discardCoarseLevels did not keep the leaf level only." );
+  checkMortonView();
+
+  std::size_t i = 0;
+  for( const auto &element : elements( grid.leafGridView(), Dune::Partitions::all ) )
+  {
+    if( element.hasFather() )
+      DUNE_THROW( Dune::GridError, "Entity on coarsest level has a father." );
+    if( grid.localIdSet().id( element ) != ids[ i++ ] )
+      DUNE_THROW( Dune::GridError, "Ids changed by discardCoarseLevels." );
+  }
+
+  for( int codim = 0; codim <= Grid::dimension; ++codim )
+  {
+    if( grid.hierarchicIndexSet().size( codim ) != grid.leafIndexSet().size( codim ) )
+      DUNE_THROW( Dune::GridError, "Hierarchic index set still contains discarded levels." );
+  }
+  checkCommunication( grid, -1, std::cout );
+}
+
+
 template< class Grid >
 Grid backupAndRestore ( const Grid &grid, const std::string &filename )
 {
@@ -143,6 +851,28 @@ void performCheck ( Grid &grid, int maxLevel, const typename Grid::RefinementPol
       Dune::checkEntityTree< 0 >( grid.levelGridView( level ) );
   }
 
+  checkTraversals( grid );
+  checkColoredTraversals( grid );
+  checkMortonOrdering( grid );
+  checkOwnerFirstOrdering( grid );
+  checkPartitionIndexSet< Dune::Interior_Partition >( grid );
+  checkPartitionIndexSet< Dune::InteriorBorder_Partition >( grid );
+  checkInverseIndex( grid );
+  checkDeepInterior( grid );
+  checkEntityRange( grid );
+  checkWavefront( grid );
+  checkForEachIndex( grid );
+  checkRowGeometry( grid );
+  checkFaceRuns( grid );
+  checkBoundaryRuns( grid );
+  checkLocalIds( grid );
+  checkDecompositionReport( grid );
+  checkLoadBalance( grid );
+  checkRefinedSubMeshes( grid );
+  std::cerr << ">>> Checking grid..." << std::endl;
+  gridcheck( grid );
+  checkCommunication( grid, -1, std::cout );
+
   Grid rgrid = backupAndRestore( grid, "gridcheck." + Grid::Refinement::type() + ".spgrid" );
   std::cerr << ">>> Checking grid..." << std::endl;
   gridcheck( rgrid );
@@ -153,6 +883,8 @@ void performCheck ( Grid &grid, int maxLevel, const typename Grid::RefinementPol
     std::cerr << ">>> Checking geometry in father..." << std::endl;
     checkGeometryInFather( rgrid );
   }
+
+  checkDiscardLevels( rgrid, policy );
 }
 
 
@@ -190,6 +922,13 @@ try
   Dune::GridPtr< Dune::SPGrid< double, dimGrid, Dune::SPArbitraryRefinement > > arbitraryGrid( dgfFile );
   performCheck( *arbitraryGrid, maxLevel, Dune::SPArbitraryRefinementPolicy< dimGrid >( 3 ) );
 
+  std::cout << std::endl;
+  std::cout << "Isotropic grid with 64-bit indices" << std::endl;
+  typedef Dune::SPGrid< double, dimGrid, Dune::SPIsotropicRefinement, Dune::MPIHelper::MPICommunicator, std::uint64_t > LongIndexGrid;
+  static_assert( std::is_same< LongIndexGrid::LeafIndexSet::IndexType, std::uint64_t >::value, "SPGrid does not use 64-bit indices." );
+  Dune::GridPtr< LongIndexGrid > longIndexGrid( dgfFile );
+  performCheck( *longIndexGrid, maxLevel );
+
   return 0;
 }
 catch( const Dune::Exception &e )